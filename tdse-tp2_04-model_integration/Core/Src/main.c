@@ -78,7 +78,11 @@ int main(void)
   /* USER CODE BEGIN 1 */
   #if (1 == LOGGER_CONFIG_USE_SEMIHOSTING)
 
-  initialise_monitor_handles();
+  /* Semihosting BKPTs hard-fault or hang without a debugger */
+  if (true == logger_debugger_attached())
+  {
+    initialise_monitor_handles();
+  }
 
   #endif
 
@@ -217,7 +221,7 @@ static void MX_GPIO_Init(void)
 
   /*Configure GPIO pin : B1_Pin */
   GPIO_InitStruct.Pin = B1_Pin;
-  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
   GPIO_InitStruct.Pull = GPIO_NOPULL;
   HAL_GPIO_Init(B1_GPIO_Port, &GPIO_InitStruct);
 
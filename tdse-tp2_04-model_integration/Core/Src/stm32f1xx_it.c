@@ -22,6 +22,17 @@
 #include "stm32f1xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include <stdbool.h>
+#include "task_actuator_attribute.h"
+#include "task_actuator_bam.h"
+#include "uart_dma_tx.h"
+#include "uart_dma_rx.h"
+#include "timer_service.h"
+#include "dwt.h"
+#include "trace.h"
+#include "cpu_load.h"
+#include "stack_monitor.h"
+#include "latency.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -183,13 +194,17 @@ void PendSV_Handler(void)
 void SysTick_Handler(void)
 {
   /* USER CODE BEGIN SysTick_IRQn 0 */
-
+  LATENCY_SYSTICK_ISR();
+  STACK_MONITOR_ISR_SAMPLE();
+  CPU_LOAD_ISR_ENTER();
+  TRACE_ISR_ENTER(TRACE_ISR_SYSTICK);
   /* USER CODE END SysTick_IRQn 0 */
   HAL_IncTick();
   /* USER CODE BEGIN SysTick_IRQn 1 */
 
   	HAL_SYSTICK_IRQHandler();
-
+  	TRACE_ISR_EXIT(TRACE_ISR_SYSTICK);
+  	CPU_LOAD_ISR_EXIT();
   /* USER CODE END SysTick_IRQn 1 */
 }
 
@@ -206,14 +221,82 @@ void SysTick_Handler(void)
 void EXTI15_10_IRQHandler(void)
 {
   /* USER CODE BEGIN EXTI15_10_IRQn 0 */
-
+  LATENCY_EXTI_ISR();
+  STACK_MONITOR_ISR_SAMPLE();
+  CPU_LOAD_ISR_ENTER();
+  TRACE_ISR_ENTER(TRACE_ISR_EXTI15_10);
   /* USER CODE END EXTI15_10_IRQn 0 */
   HAL_GPIO_EXTI_IRQHandler(B1_Pin);
   /* USER CODE BEGIN EXTI15_10_IRQn 1 */
-
+  TRACE_ISR_EXIT(TRACE_ISR_EXTI15_10);
+  CPU_LOAD_ISR_EXIT();
   /* USER CODE END EXTI15_10_IRQn 1 */
 }
 
 /* USER CODE BEGIN 1 */
+/**
+  * @brief This function handles TIM4 global interrupt (bit-angle modulation).
+  */
+void TIM4_IRQHandler(void)
+{
+  STACK_MONITOR_ISR_SAMPLE();
+  CPU_LOAD_ISR_ENTER();
+  TRACE_ISR_ENTER(TRACE_ISR_TIM4);
+  task_actuator_bam_isr();
+  TRACE_ISR_EXIT(TRACE_ISR_TIM4);
+  CPU_LOAD_ISR_EXIT();
+}
+
+/**
+  * @brief This function handles DMA1 channel7 global interrupt (USART2 TX, logger).
+  */
+void DMA1_Channel7_IRQHandler(void)
+{
+  STACK_MONITOR_ISR_SAMPLE();
+  CPU_LOAD_ISR_ENTER();
+  TRACE_ISR_ENTER(TRACE_ISR_DMA1_CH7);
+  uart_dma_tx_isr();
+  TRACE_ISR_EXIT(TRACE_ISR_DMA1_CH7);
+  CPU_LOAD_ISR_EXIT();
+}
+
+/**
+  * @brief This function handles DMA1 channel6 global interrupt (USART2 RX, shell).
+  */
+void DMA1_Channel6_IRQHandler(void)
+{
+  STACK_MONITOR_ISR_SAMPLE();
+  CPU_LOAD_ISR_ENTER();
+  TRACE_ISR_ENTER(TRACE_ISR_DMA1_CH6);
+  uart_dma_rx_isr();
+  TRACE_ISR_EXIT(TRACE_ISR_DMA1_CH6);
+  CPU_LOAD_ISR_EXIT();
+}
+
+/**
+  * @brief This function handles USART2 global interrupt (RX idle line, shell).
+  */
+void USART2_IRQHandler(void)
+{
+  STACK_MONITOR_ISR_SAMPLE();
+  CPU_LOAD_ISR_ENTER();
+  TRACE_ISR_ENTER(TRACE_ISR_USART2);
+  uart_dma_rx_isr();
+  TRACE_ISR_EXIT(TRACE_ISR_USART2);
+  CPU_LOAD_ISR_EXIT();
+}
+
+/**
+  * @brief This function handles TIM2 global interrupt (timer service).
+  */
+void TIM2_IRQHandler(void)
+{
+  STACK_MONITOR_ISR_SAMPLE();
+  CPU_LOAD_ISR_ENTER();
+  TRACE_ISR_ENTER(TRACE_ISR_TIM2);
+  timer_service_isr();
+  TRACE_ISR_EXIT(TRACE_ISR_TIM2);
+  CPU_LOAD_ISR_EXIT();
+}
 
 /* USER CODE END 1 */
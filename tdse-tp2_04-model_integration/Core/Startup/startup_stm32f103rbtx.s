@@ -94,6 +94,21 @@ LoopFillZerobss:
   cmp r2, r4
   bcc FillZerobss
 
+/* Paint the heap & stack (_end up to the SP) for the high-water scan,
+   same pattern as STACK_MONITOR_PAINT (stack_monitor.h) */
+  ldr r2, =_end
+  mov r4, sp
+  ldr r3, =0xA5A5A5A5
+  b LoopPaintStack
+
+PaintStack:
+  str  r3, [r2]
+  adds r2, r2, #4
+
+LoopPaintStack:
+  cmp r2, r4
+  bcc PaintStack
+
 /* Call static constructors */
     bl __libc_init_array
 /* Call the application's entry point.*/
@@ -64,6 +64,10 @@ extern volatile uint32_t g_app_tick_cnt;
 extern void app_init(void);
 extern void app_update(void);
 
+/* Diagnostics (shell.c): counters & per task WCET through the logger, WCET reset */
+extern void app_dump(void);
+extern void app_wcet_reset(void);
+
 /********************** End of CPP guard *************************************/
 #ifdef __cplusplus
 }
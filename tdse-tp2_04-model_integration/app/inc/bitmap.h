@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : bitmap.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef BITMAP_INC_BITMAP_H_
+#define BITMAP_INC_BITMAP_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/********************** macros ***********************************************/
+/* Number of 32-bit words needed to hold "qty" bits */
+#define BITMAP_WORDS(qty)	(((qty) + 31ul) / 32ul)
+
+/* Word index & bit mask of bit "index" */
+#define BITMAP_WORD(index)	((index) >> 5)
+#define BITMAP_MASK(index)	(1ul << ((index) & 31ul))
+
+/* set bit */
+static inline void bitmap_set(uint32_t *p_bitmap, uint32_t index) __attribute__((always_inline));
+static inline void bitmap_set(uint32_t *p_bitmap, uint32_t index)
+{
+	p_bitmap[BITMAP_WORD(index)] |= BITMAP_MASK(index);
+}
+
+/* clear bit */
+static inline void bitmap_clr(uint32_t *p_bitmap, uint32_t index) __attribute__((always_inline));
+static inline void bitmap_clr(uint32_t *p_bitmap, uint32_t index)
+{
+	p_bitmap[BITMAP_WORD(index)] &= ~BITMAP_MASK(index);
+}
+
+/* find first set bit >= "index", "qty" if none (CTZ => RBIT + CLZ on Cortex-M3) */
+static inline uint32_t bitmap_next(const uint32_t *p_bitmap, uint32_t qty, uint32_t index) __attribute__((always_inline));
+static inline uint32_t bitmap_next(const uint32_t *p_bitmap, uint32_t qty, uint32_t index)
+{
+	uint32_t word = BITMAP_WORD(index);
+	uint32_t bits;
+
+	if (qty <= index)
+		return qty;
+
+	bits = p_bitmap[word] & ~(BITMAP_MASK(index) - 1ul);
+	while (0 == bits)
+	{
+		if (BITMAP_WORDS(qty) <= ++word)
+			return qty;
+		bits = p_bitmap[word];
+	}
+
+	index = (word << 5) + (uint32_t)__builtin_ctz(bits);
+	return (index < qty) ? index : qty;
+}
+
+/* read bit */
+static inline bool bitmap_get(const uint32_t *p_bitmap, uint32_t index) __attribute__((always_inline));
+static inline bool bitmap_get(const uint32_t *p_bitmap, uint32_t index)
+{
+	return (0 != (p_bitmap[BITMAP_WORD(index)] & BITMAP_MASK(index)));
+}
+
+/********************** typedef **********************************************/
+
+/********************** external data declaration ****************************/
+
+/********************** external functions declaration ***********************/
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* BITMAP_INC_BITMAP_H_ */
+
+/********************** end of file ******************************************/
@@ -77,6 +77,11 @@ extern "C" {
 #define LED_A_ON		GPIO_PIN_SET
 #define LED_A_OFF		GPIO_PIN_RESET
 
+/* LD2 (PA5) is not a timer channel on STM32F103 => GPIO actuator */
+#define LED_A_KIND		KIND_LED_XX_GPIO
+#define LED_A_TIM		NULL
+#define LED_A_TIM_CH	(0)
+
 #endif
 
 /* STM32 Nucleo Boards - 144 Pins */
@@ -92,6 +97,10 @@ extern "C" {
 #define LED_A_ON		GPIO_PIN_SET
 #define LED_A_OFF		GPIO_PIN_RESET
 
+#define LED_A_KIND		KIND_LED_XX_GPIO
+#define LED_A_TIM		NULL
+#define LED_A_TIM_CH	(0)
+
 #endif
 
 /* STM32 Discovery Kits */
@@ -107,6 +116,10 @@ extern "C" {
 #define LED_A_ON		GPIO_PIN_SET
 #define LED_A_OFF		GPIO_PIN_RESET
 
+#define LED_A_KIND		KIND_LED_XX_GPIO
+#define LED_A_TIM		NULL
+#define LED_A_TIM_CH	(0)
+
 #endif
 
 /********************** typedef **********************************************/
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : cpu_load.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef CPU_LOAD_INC_CPU_LOAD_H_
+#define CPU_LOAD_INC_CPU_LOAD_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/********************** macros ***********************************************/
+#define CPU_LOAD_CONFIG_TASK_QTY		(3ul)	/* task_cfg_list[] entries (app.c) */
+#define CPU_LOAD_CONFIG_MINUTE_QTY		(60ul)	/* seconds in the rolling minute */
+#define CPU_LOAD_CONFIG_TELEMETRY_S		(10ul)	/* log period [S], 0 => no telemetry */
+
+/* ISR time: outermost handler only (nested ones are inside its window), hardware
+ * stacking not included. dwt.h must be included before this file.
+ *
+ *  CPU_LOAD_ISR_ENTER();
+ *  ...
+ *  CPU_LOAD_ISR_EXIT();
+ */
+#define CPU_LOAD_ISR_ENTER()		cpu_load_isr_enter()
+#define CPU_LOAD_ISR_EXIT()			cpu_load_isr_exit()
+
+/********************** typedef **********************************************/
+/* Shares of a window, per mille of its cycles: load = tasks + ISRs,
+ * idle = everything else (idle loop: logger drain, trace dump, scheduler) */
+typedef struct
+{
+	uint16_t	load;
+	uint16_t	isr;
+	uint16_t	idle;
+	uint16_t	task[CPU_LOAD_CONFIG_TASK_QTY];
+} cpu_load_pm_t;
+
+typedef struct
+{
+	cpu_load_pm_t	second;		/* last complete second */
+	cpu_load_pm_t	minute;		/* average of the last CPU_LOAD_CONFIG_MINUTE_QTY seconds */
+	uint16_t		load_max;	/* worst second since reset, per mille */
+	uint32_t		seconds;	/* complete seconds since reset */
+} cpu_load_t;
+
+/********************** external data declaration ****************************/
+/* ISR cycles, free running (task time is measured net of it) */
+extern volatile uint32_t cpu_load_isr_cycles;
+extern volatile uint32_t cpu_load_isr_depth;
+extern volatile uint32_t cpu_load_isr_start;
+
+/* Handlers only (interrupts enabled on entry): the depth & the start or the
+ * accumulation change together under a short CPSID, a preempting handler never
+ * sees one without the other */
+static inline void cpu_load_isr_enter(void) __attribute__((always_inline));
+static inline void cpu_load_isr_enter(void)
+{
+	__asm("CPSID i");	/* disable interrupts */
+	if (0 == cpu_load_isr_depth++)
+	{
+		cpu_load_isr_start = cycle_counter_get();
+	}
+	__asm("CPSIE i");	/* enable interrupts */
+}
+
+static inline void cpu_load_isr_exit(void) __attribute__((always_inline));
+static inline void cpu_load_isr_exit(void)
+{
+	__asm("CPSID i");	/* disable interrupts */
+	if (1 == cpu_load_isr_depth)
+	{
+		cpu_load_isr_cycles += cycle_counter_get() - cpu_load_isr_start;
+	}
+	cpu_load_isr_depth--;
+	__asm("CPSIE i");	/* enable interrupts */
+}
+
+/********************** external functions declaration ***********************/
+void cpu_load_init(void);
+void cpu_load_reset(void);
+
+/* Task "task" ran "cycles", ISR cycles excluded (app_update()) */
+void cpu_load_task_add(uint32_t task, uint32_t cycles);
+
+/* Once per tick: closes the second when due, periodic telemetry */
+void cpu_load_update(void);
+
+/* Copy of the last figures */
+void cpu_load_get(cpu_load_t *p_cpu_load);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CPU_LOAD_INC_CPU_LOAD_H_ */
+
+/********************** end of file ******************************************/
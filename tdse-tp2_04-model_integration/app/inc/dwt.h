@@ -47,6 +47,21 @@ extern "C" {
 
 /********************** macros ***********************************************/
 
+/* 64-bit extension of the free running CYCCNT: high word << 1 | CYCCNT bit 31
+ * seen by the last cycle_counter_extend(), one word so any context reads it whole */
+extern volatile uint32_t cycle_counter_ext;
+
+/* Cycles to microseconds without a divide: uS = (cycles * cycle_counter_us_mult) >> 32,
+ * cycle_counter_us_mult = 2^32 * 10^6 / SystemCoreClock (2^26 at 64 MHz), its next 32
+ * fractional bits in cycle_counter_us_frac keep 64-bit counts within 2 uS at any clock.
+ * cycle_counter_clock_update() derives the constants from SystemCoreClock, it is
+ * called by cycle_counter_init() and must be called again if the clock changes */
+extern uint32_t cycle_counter_us_mult;
+extern uint32_t cycle_counter_us_frac;
+extern uint32_t cycle_counter_cycles_per_us;
+
+void cycle_counter_clock_update(void);
+
 /* init cycle counter */
 /* DWT (Data Watchpoint and Trace) registers, only exists on ARM Cortex with a DWT unit */
 /*!< DEMCR: Debug Exception and Monitor Control Register */
@@ -58,6 +73,8 @@ static inline void cycle_counter_init(void)
 {
 	 CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;/* enable DWT hardware */
 	 DWT->CYCCNT = 0;								/* reset cycle counter */
+	 cycle_counter_ext = 0;							/* reset 64-bit extension */
+	 cycle_counter_clock_update();					/* conversion constants */
 	 DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;			/* start counting */
 }
 
@@ -93,10 +110,36 @@ static inline uint32_t cycle_counter_get(void)
 	return (DWT->CYCCNT);
 }
 
+/* cycles (a difference of two cycle_counter_get()) to microseconds, one UMULL */
+static inline uint32_t cycle_counter_to_us(uint32_t cycles) __attribute__((always_inline));
+static inline uint32_t cycle_counter_to_us(uint32_t cycles)
+{
+	return (uint32_t)(((uint64_t)cycles * cycle_counter_us_mult) >> 32);
+}
+
+/* 64-bit cycles (cycle_counter_get64()) to microseconds, three UMULL */
+static inline uint64_t cycle_counter_to_us64(uint64_t cycles) __attribute__((always_inline));
+static inline uint64_t cycle_counter_to_us64(uint64_t cycles)
+{
+	uint32_t hi = (uint32_t)(cycles >> 32);
+	uint32_t lo = (uint32_t)cycles;
+
+	return ((uint64_t)hi * cycle_counter_us_mult)
+		 + (((uint64_t)lo * cycle_counter_us_mult) >> 32)
+		 + (((uint64_t)hi * cycle_counter_us_frac) >> 32);
+}
+
+/* microseconds to cycles (delays & timeouts) */
+static inline uint32_t cycle_counter_from_us(uint32_t us) __attribute__((always_inline));
+static inline uint32_t cycle_counter_from_us(uint32_t us)
+{
+	return (us * cycle_counter_cycles_per_us);
+}
+
 static inline uint32_t cycle_counter_get_time_us(void) __attribute__((always_inline));
 static inline uint32_t cycle_counter_get_time_us(void)
 {
-	return (DWT->CYCCNT / (SystemCoreClock / 1000000));
+	return cycle_counter_to_us(DWT->CYCCNT);
 }
 
 /*  uint32_t cycle_counter = 0;
@@ -121,13 +164,52 @@ static inline uint32_t cycle_counter_get_time_us(void)
  *
  *  														// => ______
  *
- *  LOGGER_LOG("Cycles: %lu - Time %lu uS\r\n", cycle_counter, cycle_counter_time_us);
+ *  LOGGER_INFO("Cycles: %lu - Time %lu uS", cycle_counter, cycle_counter_time_us);
  */
 
 /********************** typedef **********************************************/
 
 /********************** external data declaration ****************************/
 
+/* extend cycle counter, call at least every 2^31 cycles (SysTick, 1 mS) */
+static inline void cycle_counter_extend(void) __attribute__((always_inline));
+static inline void cycle_counter_extend(void)
+{
+	uint32_t ext = cycle_counter_ext;
+	uint32_t msb = DWT->CYCCNT >> 31;
+
+	/* bit 31 fell from 1 to 0 => CYCCNT wrapped */
+	if ((1 == (ext & 1)) && (0 == msb))
+	{
+		ext += 2;
+	}
+	cycle_counter_ext = (ext & ~1ul) | msb;
+}
+
+/* read 64-bit cycle counter, wait-free from tasks & ISRs of any priority,
+ * CYCCNT must not be reset after cycle_counter_init() */
+static inline uint64_t cycle_counter_get64(void) __attribute__((always_inline));
+static inline uint64_t cycle_counter_get64(void)
+{
+	uint32_t ext = cycle_counter_ext;
+	uint32_t cnt = DWT->CYCCNT;
+	uint32_t hi = ext >> 1;
+
+	/* wrapped since the last extension */
+	if ((1 == (ext & 1)) && (0 == (cnt >> 31)))
+	{
+		hi++;
+	}
+	return (((uint64_t)hi << 32) | cnt);
+}
+
+/* monotonic microseconds since cycle_counter_init(), no wrap in practice */
+static inline uint64_t cycle_counter_get64_us(void) __attribute__((always_inline));
+static inline uint64_t cycle_counter_get64_us(void)
+{
+	return cycle_counter_to_us64(cycle_counter_get64());
+}
+
 /********************** external functions declaration ***********************/
 
 /********************** End of CPP guard *************************************/
@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : e2e_latency.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef E2E_LATENCY_INC_E2E_LATENCY_H_
+#define E2E_LATENCY_INC_E2E_LATENCY_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/********************** macros ***********************************************/
+/* 0 => every E2E_xx() hook compiled out */
+#ifndef E2E_CONFIG_ENABLE
+#define E2E_CONFIG_ENABLE			(1)
+#endif
+#define E2E_CONFIG_SENSOR_QTY		(16ul)	/* sensors tracked, by index */
+#define E2E_CONFIG_ACTUATOR_QTY		(16ul)	/* actuators tracked, by table index (<= 32) */
+#define E2E_CONFIG_PATH_QTY			(4ul)	/* paths with their own histogram, the last one
+											 * also takes the paths that did not fit */
+
+#define E2E_PATH_MIXED				(0xFFu)
+
+/* Stimulus to actuation: the origin stamp (CYCCNT) rides with the events.
+ * B1 edge (EXTI) or sensor leaving a stable state => task_sensor debounced edge
+ * => put_event_task_system() => get_event_task_system() => put_event_task_actuator()
+ * => task_actuator statechart => GPIO commit. Chains that do not start at a sensor
+ * are not tracked. latency.h & dwt.h must be included before this file. */
+#if 1 == E2E_CONFIG_ENABLE
+#define E2E_TASK_BEGIN()			e2e_task_begin()
+#define E2E_SENSOR_ARM(sensor)		e2e_sensor_arm(sensor)
+#define E2E_SENSOR_EMIT(sensor)		e2e_sensor_emit(sensor)
+#define E2E_SENSOR_DISARM(sensor)	e2e_sensor_disarm(sensor)
+#define E2E_ORIGIN_NOW()			e2e_origin_now()
+#define E2E_PUT(p_stamp, event)		e2e_put((p_stamp), (event))
+#define E2E_GET(p_stamp)			e2e_get(p_stamp)
+#define E2E_ACTUATOR_PUT(index, event)	e2e_actuator_put((index), (event))
+#define E2E_ACTUATOR_TAKE(index)		e2e_actuator_take(index)
+#define E2E_OUTPUT()				e2e_output()
+#else
+#define E2E_TASK_BEGIN()
+#define E2E_SENSOR_ARM(sensor)
+#define E2E_SENSOR_EMIT(sensor)
+#define E2E_SENSOR_DISARM(sensor)
+#define E2E_ORIGIN_NOW()
+#define E2E_PUT(p_stamp, event)
+#define E2E_GET(p_stamp)
+#define E2E_ACTUATOR_PUT(index, event)
+#define E2E_ACTUATOR_TAKE(index)
+#define E2E_OUTPUT()
+#endif
+
+/********************** typedef **********************************************/
+/* Per hop histograms (all paths), names in e2e_latency.c */
+typedef enum
+{
+	E2E_HOP_SENSOR,		/* stimulus => put_event_task_system() (debounce, gestures) */
+	E2E_HOP_QUEUE,		/* put_event_task_system() => get_event_task_system() */
+	E2E_HOP_SYSTEM,		/* get_event_task_system() => put_event_task_actuator() */
+	E2E_HOP_ACTUATOR,	/* put_event_task_actuator() => taken by the actuator statechart */
+	E2E_HOP_OUTPUT,		/* taken => GPIO commit */
+	E2E_HOP_QTY
+} e2e_hop_t;
+
+/* Carried with an event */
+typedef struct
+{
+	uint32_t	origin;		/* CYCCNT at the stimulus */
+	uint32_t	hop;		/* CYCCNT at the last hop */
+	uint8_t		path;		/* task_system_ev_t << 4 | task_actuator_ev_t */
+	bool		valid;
+} e2e_stamp_t;
+
+/********************** external data declaration ****************************/
+extern latency_dta_t e2e_hop_dta_list[E2E_HOP_QTY];
+extern latency_dta_t e2e_path_dta_list[E2E_CONFIG_PATH_QTY];
+extern uint8_t e2e_path_list[E2E_CONFIG_PATH_QTY];
+
+/********************** external functions declaration ***********************/
+void e2e_init(void);
+void e2e_reset(void);
+
+/* app_update(): no event in hand when a task starts */
+void e2e_task_begin(void);
+
+/* First edge of a sensor (EXTI from task_sensor_wakeup(), or the statechart
+ * leaving a stable state), its debounced edge, or back to a stable state */
+void e2e_sensor_arm(uint32_t sensor);
+void e2e_sensor_emit(uint32_t sensor);
+void e2e_sensor_disarm(uint32_t sensor);
+
+/* Stimulus is now (gesture timers) */
+void e2e_origin_now(void);
+
+/* Task system queue slot: stamp the event in hand into it, take it from it */
+void e2e_put(e2e_stamp_t *p_stamp, uint32_t event);
+void e2e_get(const e2e_stamp_t *p_stamp);
+
+/* Task actuator mailbox: event posted, event taken by the statechart, both
+ * keyed by the task_actuator_cfg_list[] index */
+void e2e_actuator_put(uint32_t index, uint32_t event);
+void e2e_actuator_take(uint32_t index);
+
+/* After the GPIO commit of the actuator pass: ends the chains taken in it */
+void e2e_output(void);
+
+/* Print hops & paths through the logger (uS) */
+void e2e_dump(void);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* E2E_LATENCY_INC_E2E_LATENCY_H_ */
+
+/********************** end of file ******************************************/
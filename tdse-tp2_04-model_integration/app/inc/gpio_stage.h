@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : gpio_stage.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef GPIO_STAGE_INC_GPIO_STAGE_H_
+#define GPIO_STAGE_INC_GPIO_STAGE_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/********************** macros ***********************************************/
+/* GPIOA .. GPIOE, 0x400 apart on the APB2 bus */
+#define GPIO_STAGE_PORT_QTY		(5ul)
+#define GPIO_STAGE_PORT_STRIDE	(GPIOB_BASE - GPIOA_BASE)
+#define GPIO_STAGE_PORT_INDEX(port)	((uint32_t)((((uintptr_t)(port)) - GPIOA_BASE) / GPIO_STAGE_PORT_STRIDE))
+
+/********************** typedef **********************************************/
+/* Staged output of one port: BSRR word (reset mask << 16 | set mask) */
+typedef struct
+{
+	uint32_t	bsrr[GPIO_STAGE_PORT_QTY];
+	uint32_t	dirty;
+} gpio_stage_t;
+
+/********************** external data declaration ****************************/
+extern gpio_stage_t gpio_stage;
+
+/********************** external functions declaration ***********************/
+/* Stage a pin write, the last write of the tick wins (task context only) */
+static inline void gpio_stage_write(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state) __attribute__((always_inline));
+static inline void gpio_stage_write(GPIO_TypeDef *port, uint16_t pin, GPIO_PinState state)
+{
+	uint32_t index = GPIO_STAGE_PORT_INDEX(port);
+
+	if (GPIO_PIN_RESET != state)
+		gpio_stage.bsrr[index] = (gpio_stage.bsrr[index] & ~((uint32_t)pin << 16)) | (uint32_t)pin;
+	else
+		gpio_stage.bsrr[index] = (gpio_stage.bsrr[index] & ~(uint32_t)pin) | ((uint32_t)pin << 16);
+
+	gpio_stage.dirty |= (1ul << index);
+}
+
+/* Write the staged masks, one BSRR store per dirty port */
+extern void gpio_stage_commit(void);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* GPIO_STAGE_INC_GPIO_STAGE_H_ */
+
+/********************** end of file ******************************************/
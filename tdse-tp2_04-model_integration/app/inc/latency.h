@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : latency.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef LATENCY_INC_LATENCY_H_
+#define LATENCY_INC_LATENCY_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/********************** macros ***********************************************/
+/* 0 => every LATENCY_xx() hook compiled out */
+#ifndef LATENCY_CONFIG_ENABLE
+#define LATENCY_CONFIG_ENABLE			(1)
+#endif
+#define LATENCY_CONFIG_EXTI_TIMEOUT_MS	(1000ul)	/* edge with no output change: dropped */
+
+/* Histogram: 4 bins per power of 2 (12.5 % wide), exact below 4 cycles,
+ * 16-bit counts halved together when one saturates */
+#define LATENCY_HIST_SUB				(2ul)
+#define LATENCY_HIST_QTY				(124ul)
+
+/* Hooks, dwt.h must be included before this file:
+ *  LATENCY_SYSTICK_ISR()	first thing in SysTick_Handler()
+ *  LATENCY_EXTI_ISR()		first thing in EXTI15_10_IRQHandler()
+ *  LATENCY_TASK_RELEASE()	app_update(), right before task_sensor_update()
+ *  LATENCY_OUTPUT()		task_actuator_update(), after a GPIO commit that wrote pins */
+#if 1 == LATENCY_CONFIG_ENABLE
+#define LATENCY_SYSTICK_ISR()		latency_systick_isr()
+#define LATENCY_EXTI_ISR()			latency_exti_isr()
+#define LATENCY_TASK_RELEASE()		latency_task_release()
+#define LATENCY_OUTPUT()			latency_output()
+#else
+#define LATENCY_SYSTICK_ISR()
+#define LATENCY_EXTI_ISR()
+#define LATENCY_TASK_RELEASE()
+#define LATENCY_OUTPUT()
+#endif
+
+/********************** typedef **********************************************/
+/* Named latencies, names in latency.c, all in cycles */
+typedef enum
+{
+	LATENCY_PROBE_SYSTICK_ENTRY,	/* SysTick reload => SysTick_Handler() (SysTick->VAL) */
+	LATENCY_PROBE_TICK_RELEASE,		/* SysTick_Handler() => task_sensor_update() */
+	LATENCY_PROBE_TICK_JITTER,		/* |task_sensor_update() period - 1 mS| */
+	LATENCY_PROBE_EXTI_OUTPUT,		/* EXTI15_10_IRQHandler() => next GPIO output change */
+	LATENCY_PROBE_QTY
+} latency_probe_t;
+
+typedef struct
+{
+	uint32_t	count;
+	uint32_t	min;
+	uint32_t	max;
+	uint16_t	hist[LATENCY_HIST_QTY];
+} latency_dta_t;
+
+typedef struct
+{
+	uint32_t	count;
+	uint32_t	min;
+	uint32_t	p50;
+	uint32_t	p99;
+	uint32_t	max;
+} latency_stat_t;
+
+/********************** external data declaration ****************************/
+extern latency_dta_t latency_dta_list[LATENCY_PROBE_QTY];
+
+/********************** external functions declaration ***********************/
+void latency_init(void);
+void latency_reset(void);
+
+/* Aggregate one measurement: count, min, max & histogram bin (CLZ) */
+void latency_add(latency_dta_t *p_dta, uint32_t cycles);
+
+void latency_systick_isr(void);
+void latency_exti_isr(void);
+void latency_task_release(void);
+void latency_output(void);
+
+/* Distribution of a histogram: min, p50, p99 & max, percentiles to 12.5 % */
+void latency_stat(const latency_dta_t *p_dta, latency_stat_t *p_stat);
+void latency_get(latency_probe_t probe, latency_stat_t *p_stat);
+
+/* Print the distributions through the logger (1 line per probe) */
+void latency_dump(void);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LATENCY_INC_LATENCY_H_ */
+
+/********************** end of file ******************************************/
@@ -52,36 +52,234 @@ extern "C" {
 /********************** macros ***********************************************/
 
 #define LOGGER_CONFIG_ENABLE                    (1)
-#define LOGGER_CONFIG_MAXLEN                    (64)
+/* Sinks compiled in, logger_sink_select() picks one at app_init(): semihosting only
+ * with a debugger attached (DHCSR C_DEBUGEN), else the UART ring, else none */
 #define LOGGER_CONFIG_USE_SEMIHOSTING           (1)
+#define LOGGER_CONFIG_USE_UART                  (1)		/* USART2 TX ring through DMA, see uart_dma_tx.h */
+
+/* Log calls pass the format & up to 8 raw 32-bit arguments (integers, pointers to
+ * constant strings, no floats), formatted by the logger (no snprintf): "%d %i %u
+ * %x %X %c %s %p %%" with "-", "0", width & "l"/"h"/"z" modifiers (ignored).
+ * Lines stream into the transport with reserve/commit, no length limit: a line
+ * that does not fit the free transport space stays in the ring & is retried on
+ * the next drain, only a line longer than the transport ring is dropped whole
+ * (logger_stats.dropped).
+ * Deferred logging: a log call only copies the format pointer & the raw arguments
+ * into a lock-free ring (tasks & ISRs), logger_drain() formats & prints in idle time.
+ * "%s" strings must outlive the record (literals, const tables). Otherwise the line
+ * is formatted at the call with interrupts disabled. LOGGER_CONFIG_DEFERRED &
+ * LOGGER_CONFIG_TOKENIZED may be set on the command line (bench/bench_logger.c). */
+#ifndef LOGGER_CONFIG_DEFERRED
+#define LOGGER_CONFIG_DEFERRED                  (1)
+#endif
+#define LOGGER_CONFIG_RING_QTY                  (32)	/* records, power of 2 */
+#define LOGGER_CONFIG_ARGS_MAX                  (8)
+#define LOGGER_CONFIG_DRAIN_QTY                 (4)		/* records per logger_drain() */
+#define LOGGER_CONFIG_STATS                     (1)		/* DWT cycles per log call */
+
+/* Deferred records carry the 64-bit cycle count (cycle_counter_get64()) taken when
+ * the record is reserved, ring order == stamp order for task & ISR producers.
+ * Text lines start with it in hex, tools/logger_decode.py shows microseconds. */
+#define LOGGER_CONFIG_STAMP_FULL_QTY            (16)	/* tokenized: absolute stamp every N frames */
+
+/* Tokenized logging (needs LOGGER_CONFIG_DEFERRED): format strings go to the non
+ * loaded ".logger_fmt" section (INFO, linked at 0, see STM32F103RBTX_FLASH.ld) and
+ * their address is a 16-bit id. logger_drain() sends binary frames instead of text:
+ *   sync (0xA5), full << 7 | level << 4 | argc, id (16-bit LE),
+ *   stamp (full: 64-bit LE cycles, else 32-bit LE delta to the previous frame),
+ *   argc x argument (32-bit LE)
+ * tools/logger_decode.py rebuilds the text from the ELF ("%s" from .rodata). */
+#ifndef LOGGER_CONFIG_TOKENIZED
+#define LOGGER_CONFIG_TOKENIZED                 (0)
+#endif
+#define LOGGER_TOKEN_SYNC                       (0xA5)
+#define LOGGER_TOKEN_HEADER_LEN                 (4)
+#define LOGGER_TOKEN_FULL                       (0x80)
+
+/* Levels, the tag & the bit in the per module runtime mask */
+#define LOGGER_LEVEL_ERROR                      (0)
+#define LOGGER_LEVEL_WARN                       (1)
+#define LOGGER_LEVEL_INFO                       (2)
+#define LOGGER_LEVEL_DEBUG                      (3)
+#define LOGGER_LEVEL_TRACE                      (4)
+#define LOGGER_LEVEL_QTY                        (5)
+#define LOGGER_LEVEL_BIT(level)                 (1u << (level))
+#define LOGGER_LEVEL_MASK(level)                ((2u << (level)) - 1u)	/* level & below */
+
+/* Compile-time floor: calls above it generate no code & no string literal.
+ * A source file may raise or lower its own floor and pick its module by defining
+ * LOGGER_MODULE_LEVEL and LOGGER_MODULE before including logger.h */
+#define LOGGER_CONFIG_LEVEL                     (LOGGER_LEVEL_INFO)
+#define LOGGER_CONFIG_RUNTIME_LEVEL             (LOGGER_LEVEL_INFO)	/* initial runtime mask */
+
+#ifndef LOGGER_MODULE_LEVEL
+#define LOGGER_MODULE_LEVEL                     LOGGER_CONFIG_LEVEL
+#endif
+
+#ifndef LOGGER_MODULE
+#define LOGGER_MODULE                           LOGGER_MODULE_APP
+#endif
+
+#if (1 == LOGGER_CONFIG_TOKENIZED) && (0 == LOGGER_CONFIG_DEFERRED)
+#error "LOGGER_CONFIG_TOKENIZED requires LOGGER_CONFIG_DEFERRED"
+#endif
 
 #if 1 == LOGGER_CONFIG_ENABLE
-#define LOGGER_LOG(...)\
-	__asm("CPSID i");	/* disable interrupts*/\
-    {\
-        logger_msg_len = snprintf(logger_msg, (LOGGER_CONFIG_MAXLEN - 1), __VA_ARGS__);\
-        logger_log_print_(logger_msg);\
-    }\
-	__asm("CPSIE i");	/* enable interrupts*/
+
+/* Number of arguments (0 .. 8) */
+#define LOGGER_NARGS_(_0, _1, _2, _3, _4, _5, _6, _7, _8, N, ...)	N
+#define LOGGER_NARGS(...)	LOGGER_NARGS_(0, ##__VA_ARGS__, 8, 7, 6, 5, 4, 3, 2, 1, 0)
+
+/* Arguments as raw words */
+#define LOGGER_ARGS_0()
+#define LOGGER_ARGS_1(a)					(uintptr_t)(a)
+#define LOGGER_ARGS_2(a, b)					(uintptr_t)(a), (uintptr_t)(b)
+#define LOGGER_ARGS_3(a, b, c)				LOGGER_ARGS_2(a, b), (uintptr_t)(c)
+#define LOGGER_ARGS_4(a, b, c, d)			LOGGER_ARGS_3(a, b, c), (uintptr_t)(d)
+#define LOGGER_ARGS_5(a, b, c, d, e)		LOGGER_ARGS_4(a, b, c, d), (uintptr_t)(e)
+#define LOGGER_ARGS_6(a, b, c, d, e, f)		LOGGER_ARGS_5(a, b, c, d, e), (uintptr_t)(f)
+#define LOGGER_ARGS_7(a, b, c, d, e, f, g)	LOGGER_ARGS_6(a, b, c, d, e, f), (uintptr_t)(g)
+#define LOGGER_ARGS_8(a, b, c, d, e, f, g, h)	LOGGER_ARGS_7(a, b, c, d, e, f, g), (uintptr_t)(h)
+#define LOGGER_CAT_(a, b)	a##b
+#define LOGGER_CAT(a, b)	LOGGER_CAT_(a, b)
+#define LOGGER_ARGS(...)	LOGGER_CAT(LOGGER_ARGS_, LOGGER_NARGS(__VA_ARGS__))(__VA_ARGS__)
+
+#if 1 == LOGGER_CONFIG_TOKENIZED
+/* Format string out of the image, its (section) address is the id, never dereferenced */
+#define LOGGER_FMT(fmt)\
+	({\
+		static const char LOGGER_CAT(logger_fmt_, __LINE__)[]\
+			__attribute__((section(".logger_fmt"), used)) = fmt;\
+		(const char *)LOGGER_CAT(logger_fmt_, __LINE__);\
+	})
+#else
+#define LOGGER_FMT(fmt)		(fmt)
+#endif
+
+#if 1 == LOGGER_CONFIG_DEFERRED
+#define LOGGER_LOG_CALL_	logger_log_deferred_
 #else
-#define LOGGER_LOG(...)
+#define LOGGER_LOG_CALL_	logger_log_sync_
 #endif
 
-#define LOGGER_INFO(...)\
-    LOGGER_LOG("[info] ");\
-    LOGGER_LOG(__VA_ARGS__);\
-    LOGGER_LOG("\n");
+#define LOGGER_LOG_LEVEL(level, fmt, ...)\
+	do\
+	{\
+		if (0 != (logger_module_mask[LOGGER_MODULE] & LOGGER_LEVEL_BIT(level)))\
+		{\
+			LOGGER_LOG_CALL_((level), LOGGER_FMT(fmt), LOGGER_NARGS(__VA_ARGS__),\
+							 (const uintptr_t [LOGGER_CONFIG_ARGS_MAX]){LOGGER_ARGS(__VA_ARGS__)});\
+		}\
+	} while (0)
+
+#if LOGGER_LEVEL_ERROR <= LOGGER_MODULE_LEVEL
+#define LOGGER_ERROR(fmt, ...)	LOGGER_LOG_LEVEL(LOGGER_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define LOGGER_ERROR(...)
+#endif
+
+#if LOGGER_LEVEL_WARN <= LOGGER_MODULE_LEVEL
+#define LOGGER_WARN(fmt, ...)	LOGGER_LOG_LEVEL(LOGGER_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#else
+#define LOGGER_WARN(...)
+#endif
+
+#if LOGGER_LEVEL_INFO <= LOGGER_MODULE_LEVEL
+#define LOGGER_INFO(fmt, ...)	LOGGER_LOG_LEVEL(LOGGER_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#else
+#define LOGGER_INFO(...)
+#endif
+
+#if LOGGER_LEVEL_DEBUG <= LOGGER_MODULE_LEVEL
+#define LOGGER_DEBUG(fmt, ...)	LOGGER_LOG_LEVEL(LOGGER_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define LOGGER_DEBUG(...)
+#endif
+
+#if LOGGER_LEVEL_TRACE <= LOGGER_MODULE_LEVEL
+#define LOGGER_TRACE(fmt, ...)	LOGGER_LOG_LEVEL(LOGGER_LEVEL_TRACE, fmt, ##__VA_ARGS__)
+#else
+#define LOGGER_TRACE(...)
+#endif
+
+#else
+#define LOGGER_ERROR(...)
+#define LOGGER_WARN(...)
+#define LOGGER_INFO(...)
+#define LOGGER_DEBUG(...)
+#define LOGGER_TRACE(...)
+#endif
 
 #define GET_NAME(var)  #var
 
 /********************** typedef **********************************************/
 
-extern char* const logger_msg;
-extern int logger_msg_len; // only for debug information
+/* Output sinks */
+typedef enum
+{
+	LOGGER_SINK_NULL,
+	LOGGER_SINK_UART,
+	LOGGER_SINK_UART_POLL,		/* blocking TXE polling, fault handlers & benchmarks */
+	LOGGER_SINK_SEMIHOSTING,
+	LOGGER_SINK_QTY
+} logger_sink_t;
+
+/* Modules with their own runtime level mask */
+typedef enum
+{
+	LOGGER_MODULE_APP,
+	LOGGER_MODULE_TASK_SYSTEM,
+	LOGGER_MODULE_TASK_SENSOR,
+	LOGGER_MODULE_TASK_ACTUATOR,
+	LOGGER_MODULE_QTY
+} logger_module_t;
+
+/* Deferred logger counters, put cost measured with the DWT cycle counter */
+typedef struct
+{
+	uint32_t	put;
+	uint32_t	dropped;
+	uint32_t	drained;
+	uint32_t	put_cycles_last;
+	uint32_t	put_cycles_max;
+	uint32_t	drain_cycles_last;	/* per record: format (or tokenize) & enqueue */
+	uint32_t	drain_cycles_max;
+	uint32_t	drain_bytes;		/* bytes output on any sink (synchronous: by the call) */
+} logger_stats_t;
+
+extern logger_stats_t logger_stats;
+
+/* Enabled levels per module (LOGGER_LEVEL_BIT), read at every call site */
+extern volatile uint8_t logger_module_mask[LOGGER_MODULE_QTY];
+extern const char * const logger_level_tag[LOGGER_LEVEL_QTY];
 
 /********************** external functions declaration ***********************/
 
 void logger_log_print_(char* const msg);
+void logger_log_write_(const char *msg, uint32_t len);
+void logger_log_deferred_(uint32_t level, const char *fmt, uint32_t argc, const uintptr_t *p_arg);
+void logger_log_sync_(uint32_t level, const char *fmt, uint32_t argc, const uintptr_t *p_arg);
+
+/* Debugger attached (DHCSR C_DEBUGEN): semihosting BKPTs are safe */
+bool logger_debugger_attached(void);
+
+/* Pick the sink (semihosting with a debugger, UART, none), returns it */
+logger_sink_t logger_sink_select(void);
+
+/* Force a sink, a sink not compiled in falls back to LOGGER_SINK_NULL */
+void logger_sink_set(logger_sink_t sink);
+logger_sink_t logger_sink_get(void);
+
+/* Runtime filtering (command channel): enabled level mask, or a level & below */
+void logger_module_mask_set(logger_module_t module, uint8_t mask);
+uint8_t logger_module_mask_get(logger_module_t module);
+void logger_module_level_set(logger_module_t module, uint32_t level);
+
+/* Format & print up to "qty" deferred records, returns the records printed */
+uint32_t logger_drain(uint32_t qty);
+
+/* Free deferred records (LOGGER_CONFIG_RING_QTY when not deferred) */
+uint32_t logger_free(void);
 
 /********************** End of CPP guard *************************************/
 #ifdef __cplusplus
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : profiler.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef PROFILER_INC_PROFILER_H_
+#define PROFILER_INC_PROFILER_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/********************** macros ***********************************************/
+#define PROFILER_CONFIG_ENABLE		(1)
+
+/* Histogram bins: bin n counts 16^n <= cycles < 16^(n + 1) (bin 0 from 0),
+ * the last one up to 2^32 (< 16 => 250 nS, ... < 256M => 4.2 S at 64 MHz) */
+#define PROFILER_HIST_QTY			(8ul)
+
+/* Target cost of a probe pair (both CYCCNT reads & the aggregation), the
+ * calibrated cost is reported against it by profiler_dump() */
+#define PROFILER_BUDGET_CYCLES		(20ul)
+
+/* Probe pair around a block: CYCCNT is free running, probes may nest.
+ * "probe" is a profiler_probe_t constant, a probe is used from one context only
+ * (the task loop or one ISR), dwt.h must be included before this file.
+ *
+ *  PROFILER_START(PROFILER_PROBE_APP_TICK);
+ *  ...
+ *  PROFILER_STOP(PROFILER_PROBE_APP_TICK);
+ *
+ * The samples are stored raw, profiler_dump() subtracts the calibrated bias of
+ * an empty pair from min, max & avg. A nested pair adds its full cost to the
+ * enclosing probe.
+ */
+#if 1 == PROFILER_CONFIG_ENABLE
+#define PROFILER_START(probe)			uint32_t profiler_start_##probe = cycle_counter_get()
+#define PROFILER_STOP(probe)			profiler_dta_add(&profiler_dta_list[(probe)], cycle_counter_get() - profiler_start_##probe)
+#define PROFILER_ADD(probe, cycles)		profiler_dta_add(&profiler_dta_list[(probe)], (cycles))
+#else
+#define PROFILER_START(probe)
+#define PROFILER_STOP(probe)
+#define PROFILER_ADD(probe, cycles)
+#endif
+
+/********************** typedef **********************************************/
+/* Named probes, names in profiler.c */
+typedef enum
+{
+	PROFILER_PROBE_APP_TICK,		/* all the tasks of one tick, nests the task probes */
+	PROFILER_PROBE_TASK_SENSOR,		/* task probes in task_cfg_list[] order (app.c) */
+	PROFILER_PROBE_TASK_SYSTEM,
+	PROFILER_PROBE_TASK_ACTUATOR,
+	PROFILER_PROBE_LOGGER_DRAIN,	/* idle passes that drained records */
+	PROFILER_PROBE_QTY
+} profiler_probe_t;
+
+/* The sample count is the sum of the histogram bins */
+typedef struct
+{
+	uint32_t	min;
+	uint32_t	max;
+	uint64_t	sum;
+	uint32_t	hist[PROFILER_HIST_QTY];
+} profiler_dta_t;
+
+/********************** external data declaration ****************************/
+extern profiler_dta_t profiler_dta_list[PROFILER_PROBE_QTY];
+
+/* Measured by profiler_init(): cycles an empty pair reports (subtracted from
+ * the samples) & cycles the whole pair costs the code around it */
+extern uint32_t profiler_bias_cycles;
+extern uint32_t profiler_overhead_cycles;
+
+/* aggregate one measurement (min, max, sum & histogram bin by CLZ) */
+static inline void profiler_dta_add(profiler_dta_t *p_dta, uint32_t cycles) __attribute__((always_inline));
+static inline void profiler_dta_add(profiler_dta_t *p_dta, uint32_t cycles)
+{
+	p_dta->sum += cycles;
+	if (p_dta->min > cycles)
+	{
+		p_dta->min = cycles;
+	}
+	if (p_dta->max < cycles)
+	{
+		p_dta->max = cycles;
+	}
+	p_dta->hist[(31u - __CLZ(cycles | 1u)) >> 2]++;
+}
+
+/********************** external functions declaration ***********************/
+void profiler_init(void);
+void profiler_reset(void);
+
+/* Print the probe table through the logger (2 lines per probe) */
+void profiler_dump(void);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PROFILER_INC_PROFILER_H_ */
+
+/********************** end of file ******************************************/
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : shell.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef SHELL_INC_SHELL_H_
+#define SHELL_INC_SHELL_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/********************** macros ***********************************************/
+/* Diagnostic shell on USART2: lines received through uart_dma_rx.h, replies
+ * through the logger (its sink, "sink 1" => USART2). shell_update() runs from
+ * the idle loop: it takes at most SHELL_CONFIG_RX_QTY bytes and runs at most one
+ * command, and only when the logger ring has room for its output, so a command
+ * never waits for the transport nor drops lines. Every command is bounded by
+ * compile-time sizes (probes, tasks, SHELL_CONFIG_PAGE_QTY instances). */
+#define SHELL_CONFIG_LINE_MAX		(48ul)	/* characters, longer lines are rejected */
+#define SHELL_CONFIG_RX_QTY			(16ul)	/* bytes taken per shell_update() */
+#define SHELL_CONFIG_ARG_MAX		(4ul)	/* command & arguments */
+#define SHELL_CONFIG_PAGE_QTY		(4ul)	/* instances per "sensors" / "actuators" */
+#define SHELL_CONFIG_LOG_QTY		(24ul)	/* free logger records to run a command */
+
+/********************** typedef **********************************************/
+typedef struct
+{
+	uint32_t	lines;
+	uint32_t	errors;		/* unknown commands & bad arguments */
+	uint32_t	rejected;	/* lines too long */
+	uint32_t	cycles_max;	/* worst command */
+} shell_stats_t;
+
+/********************** external data declaration ****************************/
+extern shell_stats_t shell_stats;
+
+/********************** external functions declaration ***********************/
+void shell_init(void);
+
+/* Idle loop: receive & run, bounded */
+void shell_update(void);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SHELL_INC_SHELL_H_ */
+
+/********************** end of file ******************************************/
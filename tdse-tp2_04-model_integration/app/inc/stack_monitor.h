@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : stack_monitor.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef STACK_MONITOR_INC_STACK_MONITOR_H_
+#define STACK_MONITOR_INC_STACK_MONITOR_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/********************** macros ***********************************************/
+/* RAM above .bss: heap from _end up (sbrk break), MSP stack from _estack down.
+ * Reset_Handler (startup_stm32f103rbtx.s) paints _end .. SP with this pattern */
+#define STACK_MONITOR_PAINT				(0xA5A5A5A5ul)
+
+#define STACK_MONITOR_CONFIG_SCAN_QTY	(32ul)	/* words checked per stack_monitor_update() */
+#define STACK_MONITOR_CONFIG_MARGIN		(256ul)	/* bytes, minimum gap between heap & stack */
+
+/* Deepest MSP seen at handler entry (hardware frame included), one compare.
+ * Sampled: a nested handler's value may be lost, the painted scan is exact */
+#define STACK_MONITOR_ISR_SAMPLE()		stack_monitor_isr_sample()
+
+/********************** typedef **********************************************/
+typedef enum
+{
+	STACK_MONITOR_OK,
+	STACK_MONITOR_STACK_OVER,		/* stack deeper than _Min_Stack_Size */
+	STACK_MONITOR_HEAP_OVER,		/* heap bigger than _Min_Heap_Size */
+	STACK_MONITOR_MARGIN,			/* heap & stack less than the margin apart */
+} stack_monitor_status_t;
+
+typedef struct
+{
+	uint32_t	stack_max;		/* bytes, high-water from the painted region */
+	uint32_t	stack_isr_max;	/* bytes, deepest handler entry */
+	uint32_t	stack_size;		/* bytes, _Min_Stack_Size */
+	uint32_t	heap_max;		/* bytes, sbrk break (it never shrinks) */
+	uint32_t	heap_size;		/* bytes, _Min_Heap_Size */
+	uint32_t	free;			/* bytes, untouched between heap & stack */
+	uint32_t	status;			/* bit per stack_monitor_status_t ever seen */
+} stack_monitor_t;
+
+/********************** external data declaration ****************************/
+extern volatile uint32_t stack_monitor_isr_sp_min;
+
+static inline void stack_monitor_isr_sample(void) __attribute__((always_inline));
+static inline void stack_monitor_isr_sample(void)
+{
+	uint32_t sp = __get_MSP();
+
+	if (stack_monitor_isr_sp_min > sp)
+	{
+		stack_monitor_isr_sp_min = sp;
+	}
+}
+
+/********************** external functions declaration ***********************/
+void stack_monitor_init(void);
+
+/* Idle: a bounded slice of the high-water scan, reports new out-of-margin conditions */
+void stack_monitor_update(void);
+
+void stack_monitor_get(stack_monitor_t *p_stack_monitor);
+
+/* Print the figures through the logger */
+void stack_monitor_dump(void);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* STACK_MONITOR_INC_STACK_MONITOR_H_ */
+
+/********************** end of file ******************************************/
@@ -46,14 +46,33 @@ extern "C" {
 /********************** inclusions *******************************************/
 
 /********************** macros ***********************************************/
+/* now_cycles()/now_us(): monotonic since HAL_Init(), uwTick (1 mS, HAL_TICK_FREQ_1KHZ)
+ * extended to 64-bit by systick_extend() (HAL_SYSTICK_Callback()) plus the elapsed
+ * part of the SysTick down counter (processor clock). Valid from tasks & ISRs as long
+ * as interrupts are not masked for a whole tick. Same units as cycle_counter_get64()
+ * (dwt.h) without the DWT unit, e.g. under a debugger using it.
+ * now_us() converts the part of the tick with the dwt.h constants (cycle_counter_init()).
+ * The stamps stay on the DWT: cycle_counter_get64() for the logger, the 32-bit
+ * cycle_counter_get() for trace, latency & e2e (differences, wrap safe). One register
+ * read, no retry loop, valid at any priority & with interrupts masked (synchronous
+ * logger). now_cycles() is the fallback time base, used by systick_delay_us(). */
 
 /********************** typedef **********************************************/
 
 /********************** external data declaration ****************************/
+/* 64-bit extension of uwTick: high word << 1 | uwTick bit 31 seen by the last
+ * systick_extend(), one word so any context reads it whole */
+extern volatile uint32_t systick_tick_ext;
 
 /********************** external functions declaration ***********************/
+/* extend uwTick, call at least every 2^31 ticks (SysTick, 1 mS) */
+void systick_extend(void);
+
 void systick_delay_us(uint32_t delay_us);
 
+uint64_t now_cycles(void);
+uint64_t now_us(void);
+
 /********************** End of CPP guard *************************************/
 #ifdef __cplusplus
 }
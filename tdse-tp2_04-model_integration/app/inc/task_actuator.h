@@ -52,11 +52,17 @@ extern "C" {
 /********************** external data declaration ****************************/
 extern uint32_t g_task_actuator_cnt;
 extern volatile uint32_t g_task_actuator_tick_cnt;
+extern uint32_t g_task_actuator_ev_dropped;		/* events a state does not take */
 
 /********************** external functions declaration ***********************/
 extern void task_actuator_init(void *parameters);
 extern void task_actuator_update(void *parameters);
 
+/* Diagnostics & tuning (shell.c): log up to "qty" actuators from "first", returns
+ * the next one; blink & pulse ticks (0 keeps it), false when out of range or not tunable */
+extern uint32_t task_actuator_dump(uint32_t first, uint32_t qty);
+extern bool task_actuator_tick_set(uint32_t index, uint32_t tick_blink, uint32_t tick_pulse);
+
 /********************** End of CPP guard *************************************/
 #ifdef __cplusplus
 }
@@ -46,6 +46,46 @@ extern "C" {
 /********************** inclusions *******************************************/
 
 /********************** macros ***********************************************/
+/* Data layout: 0 => array of structures (task_actuator_dta_list[])
+ *              1 => structure of arrays, 8-bit state & event, flag bitmap
+ * May be set on the command line (bench/bench_task_layout.c). */
+#ifndef TASK_ACTUATOR_CONFIG_SOA
+#define TASK_ACTUATOR_CONFIG_SOA	(0)
+#endif
+
+/* Configuration table: 0 => flash (const)
+ *                      1 => RAM, tick_blink & tick_pulse tunable at runtime (shell.c) */
+#define TASK_ACTUATOR_CONFIG_TUNABLE	(1)
+
+/* Configuration table: 1 => board.h actuators (task_actuator.c)
+ *                      0 => defined by the file including task_actuator.c (bench/) */
+#ifndef TASK_ACTUATOR_CONFIG_BOARD
+#define TASK_ACTUATOR_CONFIG_BOARD	(1)
+#endif
+
+/* Brightness of an ON actuator, in % (dimming on KIND_LED_XX_TIM & KIND_LED_XX_BAM) */
+#define LED_XX_BRIGHTNESS_MAX		(100ul)
+
+/* Task Actuator Data accessors, valid for both layouts */
+#if (1 == TASK_ACTUATOR_CONFIG_SOA)
+#define TASK_ACTUATOR_DTA_TICK(index)		(task_actuator_dta_tick[(index)])
+#define TASK_ACTUATOR_DTA_STATE(index)		(task_actuator_dta_state[(index)])
+#define TASK_ACTUATOR_DTA_EVENT(index)		(task_actuator_dta_event[(index)])
+#define TASK_ACTUATOR_DTA_FLAG(index)		(bitmap_get(task_actuator_dta_flag, (index)))
+#define TASK_ACTUATOR_DTA_FLAG_SET(index)	(bitmap_set(task_actuator_dta_flag, (index)))
+#define TASK_ACTUATOR_DTA_FLAG_CLR(index)	(bitmap_clr(task_actuator_dta_flag, (index)))
+#else
+#define TASK_ACTUATOR_DTA_TICK(index)		(task_actuator_dta_list[(index)].tick)
+#define TASK_ACTUATOR_DTA_STATE(index)		(task_actuator_dta_list[(index)].state)
+#define TASK_ACTUATOR_DTA_EVENT(index)		(task_actuator_dta_list[(index)].event)
+#define TASK_ACTUATOR_DTA_FLAG(index)		(task_actuator_dta_list[(index)].flag)
+#define TASK_ACTUATOR_DTA_FLAG_SET(index)	(task_actuator_dta_list[(index)].flag = true)
+#define TASK_ACTUATOR_DTA_FLAG_CLR(index)	(task_actuator_dta_list[(index)].flag = false)
+#endif
+
+/* Active actuators (event pending or tick counting), the others are skipped */
+#define TASK_ACTUATOR_DTA_ACTIVE_SET(index)	(bitmap_set(task_actuator_dta_active, (index)))
+#define TASK_ACTUATOR_DTA_ACTIVE_CLR(index)	(bitmap_clr(task_actuator_dta_active, (index)))
 
 /********************** typedef **********************************************/
 /* Actuator Statechart - State Transition Table */
@@ -99,25 +139,88 @@ extern "C" {
  * 	|                       |                       |                       |                       | op_led(led)           |
  * 	|-----------------------+-----------------------+-----------------------+-----------------------+-----------------------|
  * 	|                       |                       | [tick >  0]           | ST_LED_XX_PULSE       | tick--                |
- * 	------------------------+-----------------------+-----------------------+-----------------------+------------------------ */
+ * 	------------------------+-----------------------+-----------------------+-----------------------+------------------------
+ *
+ * 	Pattern sequencer (task_actuator_pattern.h)
+ * 	------------------------+-----------------------+-----------------------+-----------------------+------------------------
+ * 	| ST_LED_XX_OFF         | EV_LED_XX_PATTERN     | [pattern available]   | ST_LED_XX_PATTERN     | step = 0              |
+ * 	| ST_LED_XX_ON          | (pattern)             |                       |                       | led = level[step]     |
+ * 	| ST_LED_XX_BLINK_ON    |                       |                       |                       | op_led(led)           |
+ * 	| ST_LED_XX_BLINK_OFF   |                       |                       |                       |                       |
+ * 	|-----------------------+-----------------------+-----------------------+-----------------------+-----------------------|
+ * 	| ST_LED_XX_PATTERN     | EV_LED_XX_OFF         |                       | ST_LED_XX_OFF         | led = LED_OFF         |
+ * 	|                       |                       |                       |                       | op_led(led)           |
+ * 	|                       +-----------------------+-----------------------+-----------------------+-----------------------|
+ * 	|                       | EV_LED_XX_ON          |                       | ST_LED_XX_ON          | led = LED_ON          |
+ * 	|                       |                       |                       |                       | op_led(led)           |
+ * 	|                       +-----------------------+-----------------------+-----------------------+-----------------------|
+ * 	|                       | EV_LED_XX_BLINK       |                       | ST_LED_XX_BLINK_ON    | stop pattern          |
+ * 	|                       |                       |                       |                       | tick = tick_max       |
+ * 	|                       |                       |                       |                       | led = LED_ON          |
+ * 	|                       |                       |                       |                       | op_led(led)           |
+ * 	|                       +-----------------------+-----------------------+-----------------------+-----------------------|
+ * 	|                       | EV_LED_XX_PULSE       |                       | ST_LED_XX_PULSE       | stop pattern          |
+ * 	|                       |                       |                       |                       | tick = tick_max       |
+ * 	|                       |                       |                       |                       | led = LED_ON          |
+ * 	|                       |                       |                       |                       | op_led(led)           |
+ * 	|                       +-----------------------+-----------------------+-----------------------+-----------------------|
+ * 	|                       | EV_LED_XX_PATTERN     | [pattern available]   | ST_LED_XX_PATTERN     | step = 0              |
+ * 	|                       | (pattern)             |                       |                       | led = level[step]     |
+ * 	|                       |                       |                       |                       | op_led(led)           |
+ * 	|                       +-----------------------+-----------------------+-----------------------+-----------------------|
+ * 	|                       |                       | [deadline, not last]  | ST_LED_XX_PATTERN     | step++                |
+ * 	|                       |                       |                       |                       | led = level[step]     |
+ * 	|                       |                       |                       |                       | op_led(led)           |
+ * 	|                       +-----------------------+-----------------------+-----------------------+-----------------------|
+ * 	|                       |                       | [deadline, last]      | ST_LED_XX_OFF         | led = LED_OFF         |
+ * 	|                       |                       | [!repeat]             |                       | op_led(led)           |
+ * 	------------------------+-----------------------+-----------------------+-----------------------+------------------------
+ * 	Deadlines live in one min-heap driven by g_task_actuator_cnt, not in the per-actuator tick.
+ *
+ * 	An event a state does not list is consumed & counted (g_task_actuator_ev_dropped), it is
+ * 	never left pending. ST_LED_XX_PULSE keeps it for ST_LED_XX_OFF, at the end of the pulse.
+ *
+ * 	KIND_LED_XX_TIM actuators run blink, pulse & dimming in a TIM channel (task_actuator_tim.h):
+ * 	op_led() programs the timer on entry, ST_LED_XX_BLINK_ON stays until the next event
+ * 	(no tick--) and the one-pulse counter shapes ST_LED_XX_PULSE.
+ * 	KIND_LED_XX_BAM actuators follow the table as GPIO ones, op_led() sets the BAM level
+ * 	(task_actuator_bam.h) instead of the pin.
+ * 	Every pulse ends on a timer_service one-shot (timer_service.h) of tick_pulse mS, one tick
+ * 	more on KIND_LED_XX_TIM, instead of the tick-- (or the polled TIM counter), which is only
+ * 	kept when no timer is free: a pulse costs no CPU per tick.
+ */
 
 /* Events to excite Task Actuator */
 typedef enum task_actuator_ev {EV_LED_XX_OFF,
 							   EV_LED_XX_ON,
 							   EV_LED_XX_NOT_BLINK,
 							   EV_LED_XX_BLINK,
-							   EV_LED_XX_PULSE} task_actuator_ev_t;
+							   EV_LED_XX_PULSE,
+							   EV_LED_XX_PATTERN} task_actuator_ev_t;
 
 /* States of Task Actuator */
 typedef enum task_actuator_st {ST_LED_XX_OFF,
 							   ST_LED_XX_ON,
 							   ST_LED_XX_BLINK_ON,
 							   ST_LED_XX_BLINK_OFF,
-							   ST_LED_XX_PULSE} task_actuator_st_t;
+							   ST_LED_XX_PULSE,
+							   ST_LED_XX_PATTERN} task_actuator_st_t;
 
 /* Identifier of Task Actuator */
 typedef enum task_actuator_id {ID_LED_A} task_actuator_id_t;
 
+/* Patterns of Task Actuator (EV_LED_XX_PATTERN parameter) */
+typedef enum task_actuator_pattern_id {PATTERN_LED_XX_SOS,
+									   PATTERN_LED_XX_FAULT_2,
+									   PATTERN_LED_XX_FAULT_3,
+									   PATTERN_LED_XX_BREATHING,
+									   PATTERN_LED_XX_HEARTBEAT} task_actuator_pattern_id_t;
+
+/* Kind (output backend) of Task Actuator */
+typedef enum task_actuator_kind {KIND_LED_XX_GPIO,
+								 KIND_LED_XX_TIM,
+								 KIND_LED_XX_BAM} task_actuator_kind_t;
+
 typedef struct
 {
 	task_actuator_id_t	identifier;
@@ -127,6 +230,10 @@ typedef struct
 	GPIO_PinState		led_off;
 	uint32_t			tick_blink;
 	uint32_t			tick_pulse;
+	task_actuator_kind_t kind;
+	TIM_TypeDef *		tim;
+	uint32_t			tim_channel;
+	uint32_t			brightness;
 } task_actuator_cfg_t;
 
 typedef struct
@@ -138,7 +245,15 @@ typedef struct
 } task_actuator_dta_t;
 
 /********************** external data declaration ****************************/
+#if (1 == TASK_ACTUATOR_CONFIG_SOA)
+extern uint32_t task_actuator_dta_tick[];
+extern uint8_t task_actuator_dta_state[];
+extern uint8_t task_actuator_dta_event[];
+extern uint32_t task_actuator_dta_flag[];
+#else
 extern task_actuator_dta_t task_actuator_dta_list[];
+#endif
+extern uint32_t task_actuator_dta_active[];
 
 /********************** external functions declaration ***********************/
 
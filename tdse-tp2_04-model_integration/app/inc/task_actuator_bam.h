@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : task_actuator_bam.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef TASK_INC_TASK_ACTUATOR_BAM_H_
+#define TASK_INC_TASK_ACTUATOR_BAM_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/********************** macros ***********************************************/
+/* Bit-angle modulation (soft-PWM) of KIND_LED_XX_BAM actuators on any GPIO pin
+ *  bit b of every LED level is output for 2^b units, one TIM4 update per bit:
+ *  TASK_ACTUATOR_BAM_BITS interrupts per period, each one BSRR write per port in use,
+ *  whatever the number of LEDs. Levels (0 .. LED_XX_BRIGHTNESS_MAX) are scaled to
+ *  0 .. 2^BITS - 1 and the per-bit BSRR masks are rebuilt in task context only on change.
+ * e.g. {ID_LED_C, GPIOB, GPIO_PIN_0, GPIO_PIN_SET, GPIO_PIN_RESET,
+ *	 DEL_LED_XX_BLI, DEL_LED_XX_PUL, KIND_LED_XX_BAM, NULL, 0, 25} */
+#define TASK_ACTUATOR_BAM_TIM		TIM4
+#define TASK_ACTUATOR_BAM_IRQn		TIM4_IRQn
+#define TASK_ACTUATOR_BAM_BITS		(8ul)
+#define TASK_ACTUATOR_BAM_FREQ_HZ	(200ul)		/* refresh rate of every LED */
+#define TASK_ACTUATOR_BAM_CNT_HZ	(1000000ul)	/* TIM4 counter clock */
+#define TASK_ACTUATOR_BAM_IRQ_PRIO	(1ul)
+
+/* Actuators (table index < QTY_MAX) able to be KIND_LED_XX_BAM, at least every
+ * actuator of the table (static assert in task_actuator.c).
+ * May be set on the command line (bench/, instances > 32). */
+#ifndef TASK_ACTUATOR_BAM_QTY_MAX
+#define TASK_ACTUATOR_BAM_QTY_MAX	(32ul)
+#endif
+
+/********************** typedef **********************************************/
+/* Interrupt cost, measured with the DWT cycle counter */
+typedef struct
+{
+	uint32_t	led_qty;
+	uint32_t	port_qty;
+	uint32_t	isr_cycles_last;
+	uint32_t	isr_cycles_max;
+	uint32_t	period_cnt;
+} task_actuator_bam_stats_t;
+
+/********************** external data declaration ****************************/
+extern task_actuator_bam_stats_t task_actuator_bam_stats;
+
+/********************** external functions declaration ***********************/
+extern void task_actuator_bam_init(void);
+extern void task_actuator_bam_attach(uint32_t index, const task_actuator_cfg_t *p_cfg);
+
+/* Start TIM4 once every BAM actuator is attached (no-op without them) */
+extern void task_actuator_bam_start(void);
+extern void task_actuator_bam_level(uint32_t index, uint32_t level);
+
+/* Rebuild the per-bit masks if a level changed (end of the actuator pass) */
+extern void task_actuator_bam_update(void);
+
+/* TIM4_IRQHandler() */
+extern void task_actuator_bam_isr(void);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_INC_TASK_ACTUATOR_BAM_H_ */
+
+/********************** end of file ******************************************/
@@ -53,6 +53,7 @@ extern "C" {
 
 /********************** external functions declaration ***********************/
 extern void put_event_task_actuator(task_actuator_ev_t event, task_actuator_id_t identifier);
+extern void put_event_task_actuator_pattern(task_actuator_pattern_id_t pattern, task_actuator_id_t identifier);
 
 /********************** End of CPP guard *************************************/
 #ifdef __cplusplus
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : task_actuator_pattern.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef TASK_INC_TASK_ACTUATOR_PATTERN_H_
+#define TASK_INC_TASK_ACTUATOR_PATTERN_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/********************** macros ***********************************************/
+/* Actuators (index < QTY_MAX) able to play patterns, at least every actuator of the
+ * table (static assert in task_actuator.c), 16-bit heap positions (< 0xFFFF).
+ * May be set on the command line (bench/, instances > 8). */
+#ifndef TASK_ACTUATOR_PATTERN_QTY_MAX
+#define TASK_ACTUATOR_PATTERN_QTY_MAX	(8ul)
+#endif
+
+/* mS per unit of step duration */
+#define TASK_ACTUATOR_PATTERN_TICK		(10ul)
+
+/********************** typedef **********************************************/
+/* Run-length step: level (0 .. LED_XX_BRIGHTNESS_MAX) held for dur (> 0) x 10 mS */
+typedef struct
+{
+	uint8_t		level;
+	uint8_t		dur;
+} task_actuator_pattern_step_t;
+
+/* Pattern table (flash) */
+typedef struct
+{
+	const task_actuator_pattern_step_t *p_step;
+	uint16_t	qty;
+	bool		repeat;
+} task_actuator_pattern_t;
+
+/********************** external data declaration ****************************/
+extern const task_actuator_pattern_t task_actuator_pattern_list[];
+
+/********************** external functions declaration ***********************/
+extern void task_actuator_pattern_init(void);
+
+/* Pattern played by the next EV_LED_XX_PATTERN of actuator "index" */
+extern void task_actuator_pattern_request(uint32_t index, task_actuator_pattern_id_t pattern);
+
+/* Start the requested pattern at "now" (mS), *p_level = level of the first step */
+extern bool task_actuator_pattern_start(uint32_t index, uint32_t now, uint32_t *p_level);
+extern void task_actuator_pattern_stop(uint32_t index);
+
+/* Next transition due at "now", call until false: O(log n) per transition, O(1) if none */
+extern bool task_actuator_pattern_next(uint32_t now, uint32_t *p_index, uint32_t *p_level, bool *p_end);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_INC_TASK_ACTUATOR_PATTERN_H_ */
+
+/********************** end of file ******************************************/
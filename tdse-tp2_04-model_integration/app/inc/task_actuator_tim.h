@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : task_actuator_tim.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef TASK_INC_TASK_ACTUATOR_TIM_H_
+#define TASK_INC_TASK_ACTUATOR_TIM_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/********************** macros ***********************************************/
+/* Hardware-timer backend of KIND_LED_XX_TIM actuators (register level, no HAL TIM)
+ *  blink => PWM mode 1, 10 KHz counts (16-bit PSC up to 655 MHz), period = 2 * tick_blink
+ *           (up to 6552 mS), duty = 50 %
+ *  pulse => one-pulse mode (PWM mode 2), 10 KHz counts, width = tick_pulse mS (up to 6553 mS),
+ *           the state ends on a timer_service one-shot (task_actuator.c)
+ *  on    => forced active, or 1 KHz PWM when brightness < LED_XX_BRIGHTNESS_MAX
+ *  off   => counter stopped, forced inactive
+ *  level => as on, with brightness = level (pattern steps), 0 => off
+ * All channels of a TIM share its time base (PSC, ARR, CEN), so use one actuator per TIM.
+ * TIM1 or TIM3 only: TIM2 is timer_service.c's, TIM4 task_actuator_bam.c's. Any other
+ * timer or channel is rejected by task_actuator_tim_init(), the actuator stays dark.
+ * e.g. on STM32F103: PA6 => TIM3, channel 1
+ *	{ID_LED_B, GPIOA, GPIO_PIN_6, GPIO_PIN_SET, GPIO_PIN_RESET,
+ *	 DEL_LED_XX_BLI, DEL_LED_XX_PUL, KIND_LED_XX_TIM, TIM3, 1, 50} */
+
+/********************** typedef **********************************************/
+
+/********************** external data declaration ****************************/
+
+/********************** external functions declaration ***********************/
+extern bool task_actuator_tim_init(const task_actuator_cfg_t *p_cfg);
+extern void task_actuator_tim_on(const task_actuator_cfg_t *p_cfg);
+extern void task_actuator_tim_off(const task_actuator_cfg_t *p_cfg);
+extern void task_actuator_tim_level(const task_actuator_cfg_t *p_cfg, uint32_t level);
+extern void task_actuator_tim_blink(const task_actuator_cfg_t *p_cfg);
+extern void task_actuator_tim_pulse(const task_actuator_cfg_t *p_cfg);
+extern bool task_actuator_tim_busy(const task_actuator_cfg_t *p_cfg);
+
+/* TIMxCLK of a timer, in Hz */
+extern uint32_t task_actuator_tim_clk(const TIM_TypeDef *tim);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TASK_INC_TASK_ACTUATOR_TIM_H_ */
+
+/********************** end of file ******************************************/
@@ -57,6 +57,14 @@ extern volatile uint32_t g_task_sensor_tick_cnt;
 extern void task_sensor_init(void *parameters);
 extern void task_sensor_update(void *parameters);
 
+/* EXTI edge on "pin": the sensors on it leave the idle set (interrupt context) */
+extern void task_sensor_wakeup(uint16_t pin);
+
+/* Diagnostics & tuning (shell.c): log up to "qty" sensors from "first", returns
+ * the next one; debounce ticks, false when out of range or not tunable */
+extern uint32_t task_sensor_dump(uint32_t first, uint32_t qty);
+extern bool task_sensor_tick_max_set(uint32_t index, uint32_t tick_max);
+
 /********************** End of CPP guard *************************************/
 #ifdef __cplusplus
 }
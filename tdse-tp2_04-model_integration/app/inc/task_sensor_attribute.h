@@ -46,6 +46,33 @@ extern "C" {
 /********************** inclusions *******************************************/
 
 /********************** macros ***********************************************/
+/* Data layout: 0 => array of structures (task_sensor_dta_list[])
+ *              1 => structure of arrays, 8-bit state & event
+ * May be set on the command line (bench/bench_task_layout.c). */
+#ifndef TASK_SENSOR_CONFIG_SOA
+#define TASK_SENSOR_CONFIG_SOA		(0)
+#endif
+
+/* Configuration table: 0 => flash (const)
+ *                      1 => RAM, tick_max tunable at runtime (shell.c) */
+#define TASK_SENSOR_CONFIG_TUNABLE	(1)
+
+/* Configuration table: 1 => board.h sensors (task_sensor.c)
+ *                      0 => defined by the file including task_sensor.c (bench/) */
+#ifndef TASK_SENSOR_CONFIG_BOARD
+#define TASK_SENSOR_CONFIG_BOARD	(1)
+#endif
+
+/* Task Sensor Data accessors, valid for both layouts */
+#if (1 == TASK_SENSOR_CONFIG_SOA)
+#define TASK_SENSOR_DTA_TICK(index)		(task_sensor_dta_tick[(index)])
+#define TASK_SENSOR_DTA_STATE(index)	(task_sensor_dta_state[(index)])
+#define TASK_SENSOR_DTA_EVENT(index)	(task_sensor_dta_event[(index)])
+#else
+#define TASK_SENSOR_DTA_TICK(index)		(task_sensor_dta_list[(index)].tick)
+#define TASK_SENSOR_DTA_STATE(index)	(task_sensor_dta_list[(index)].state)
+#define TASK_SENSOR_DTA_EVENT(index)	(task_sensor_dta_list[(index)].event)
+#endif
 
 /********************** typedef **********************************************/
 /* Sensor Statechart - State Transition Table */
@@ -83,6 +110,40 @@ extern "C" {
  * 	------------------------+-----------------------+-----------------------+-----------------------+------------------------
  */
 
+/* Sensor Gesture Statechart - State Transition Table */
+/* Runs only on debounced edges (put by the Sensor Statechart) and on gesture timer expiries */
+/* 	------------------------+-----------------------+-----------------------+-----------------------+------------------------
+ * 	| Current               | Event                 |                       | Next                  |                       |
+ * 	| State                 | (Parameters)          | [Guard]               | State                 | Actions               |
+ * 	|=======================+=======================+=======================+=======================+=======================|
+ * 	| INICIAL               |                       |                       | ST_GES_XX_IDLE        |                       |
+ * 	|-----------------------+-----------------------+-----------------------+-----------------------+-----------------------|
+ * 	| ST_GES_XX_IDLE        | EV_GES_XX_DOWN        | [chord]               | ST_GES_XX_HOLD        | put_event_task_system |
+ * 	|                       |                       |                       |                       |  (signal_chord)       |
+ * 	|                       |                       +-----------------------+-----------------------+-----------------------|
+ * 	|                       |                       | [!chord]              | ST_GES_XX_PRESSED     | timer = tick_long     |
+ * 	|-----------------------+-----------------------+-----------------------+-----------------------+-----------------------|
+ * 	| ST_GES_XX_PRESSED     | EV_GES_XX_UP          |                       | ST_GES_XX_RELEASED    | timer = tick_double   |
+ * 	|                       +-----------------------+-----------------------+-----------------------+-----------------------|
+ * 	|                       | EV_GES_XX_TIMEOUT     |                       | ST_GES_XX_HOLD        | put_event_task_system |
+ * 	|                       |                       |                       |                       |  (signal_long)        |
+ * 	|-----------------------+-----------------------+-----------------------+-----------------------+-----------------------|
+ * 	| ST_GES_XX_RELEASED    | EV_GES_XX_DOWN        | [chord]               | ST_GES_XX_HOLD        | put_event_task_system |
+ * 	|                       |                       |                       |                       |  (signal_chord)       |
+ * 	|                       |                       +-----------------------+-----------------------+-----------------------|
+ * 	|                       |                       | [!chord]              | ST_GES_XX_HOLD        | put_event_task_system |
+ * 	|                       |                       |                       |                       |  (signal_double)      |
+ * 	|                       +-----------------------+-----------------------+-----------------------+-----------------------|
+ * 	|                       | EV_GES_XX_TIMEOUT     |                       | ST_GES_XX_IDLE        |                       |
+ * 	|-----------------------+-----------------------+-----------------------+-----------------------+-----------------------|
+ * 	| ST_GES_XX_HOLD        | EV_GES_XX_UP          |                       | ST_GES_XX_IDLE        |                       |
+ * 	------------------------+-----------------------+-----------------------+-----------------------+------------------------
+ *
+ * 	[chord]: chord_with sensor is down and was pressed less than tick_chord ago
+ * 	A tick_long / tick_double / tick_chord equal to 0 disables that gesture,
+ * 	a chord_with equal to the own identifier disables the chord
+ */
+
 /* Events to excite Task Sensor */
 typedef enum task_sensor_ev {EV_BTN_XX_UP,
 							 EV_BTN_XX_DOWN} task_sensor_ev_t;
@@ -93,9 +154,21 @@ typedef enum task_sensor_st {ST_BTN_XX_UP,
 							 ST_BTN_XX_DOWN,
 						     ST_BTN_XX_RISING} task_sensor_st_t;
 
+/* Events to excite Task Sensor Gesture */
+typedef enum task_sensor_gesture_ev {EV_GES_XX_UP,
+									 EV_GES_XX_DOWN,
+									 EV_GES_XX_TIMEOUT} task_sensor_gesture_ev_t;
+
+/* States of Task Sensor Gesture */
+typedef enum task_sensor_gesture_st {ST_GES_XX_IDLE,
+									 ST_GES_XX_PRESSED,
+									 ST_GES_XX_RELEASED,
+									 ST_GES_XX_HOLD} task_sensor_gesture_st_t;
+
 /* Identifier of Task Sensor */
 typedef enum task_sensor_id {ID_BTN_A} task_sensor_id_t;
 
+/* signal_*: events put to Task System, task_system_attribute.h comes first */
 typedef struct
 {
 	task_sensor_id_t	identifier;
@@ -103,8 +176,15 @@ typedef struct
 	uint16_t			pin;
 	GPIO_PinState		pressed;
 	uint32_t			tick_max;
-	task_sensor_ev_t	signal_up;
-	task_sensor_ev_t	signal_down;
+	task_system_ev_t	signal_up;
+	task_system_ev_t	signal_down;
+	uint32_t			tick_long;
+	uint32_t			tick_double;
+	uint32_t			tick_chord;
+	task_sensor_id_t	chord_with;
+	task_system_ev_t	signal_long;
+	task_system_ev_t	signal_double;
+	task_system_ev_t	signal_chord;
 } task_sensor_cfg_t;
 
 typedef struct
@@ -114,8 +194,22 @@ typedef struct
 	task_sensor_ev_t	event;
 } task_sensor_dta_t;
 
+typedef struct
+{
+	uint32_t					timer;
+	uint32_t					tick_down;
+	task_sensor_gesture_st_t	state;
+	bool						armed;
+} task_sensor_gesture_dta_t;
+
 /********************** external data declaration ****************************/
+#if (1 == TASK_SENSOR_CONFIG_SOA)
+extern uint32_t task_sensor_dta_tick[];
+extern uint8_t task_sensor_dta_state[];
+extern uint8_t task_sensor_dta_event[];
+#else
 extern task_sensor_dta_t task_sensor_dta_list[];
+#endif
 
 /********************** external functions declaration ***********************/
 
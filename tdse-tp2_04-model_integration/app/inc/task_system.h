@@ -57,6 +57,9 @@ extern volatile uint32_t g_task_system_tick_cnt;
 extern void task_system_init(void *parameters);
 extern void task_system_update(void *parameters);
 
+/* Diagnostics (shell.c): state & queue depth through the logger */
+extern void task_system_dump(void);
+
 /********************** End of CPP guard *************************************/
 #ifdef __cplusplus
 }
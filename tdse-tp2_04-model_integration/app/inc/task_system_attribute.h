@@ -91,7 +91,10 @@ typedef enum task_system_ev {EV_SYS_IDLE,
 							 EV_SYS_MANUAL_BTN,
 							 EV_SYS_NOT_MANUAL_BTN,
 							 EV_SYS_IR_PHO_CELL,
-							 EV_SYS_NOT_IR_PHO_CELL} task_system_ev_t;
+							 EV_SYS_NOT_IR_PHO_CELL,
+							 EV_SYS_BTN_LONG_PRESS,
+							 EV_SYS_BTN_DOUBLE_CLICK,
+							 EV_SYS_BTN_CHORD} task_system_ev_t;
 
 /* State of Task System */
 typedef enum task_system_st {ST_SYS_IDLE,
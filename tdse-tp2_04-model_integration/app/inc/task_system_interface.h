@@ -57,6 +57,11 @@ extern void put_event_task_system(task_system_ev_t event);
 extern task_system_ev_t get_event_task_system(void);
 extern bool any_event_task_system(void);
 
+/* Queue depth & its high-water mark (shell.c) */
+extern uint32_t count_event_task_system(void);
+extern uint32_t count_max_event_task_system(void);
+extern void clear_count_max_event_task_system(void);
+
 /********************** End of CPP guard *************************************/
 #ifdef __cplusplus
 }
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : timer_service.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef TIMER_SERVICE_INC_TIMER_SERVICE_H_
+#define TIMER_SERVICE_INC_TIMER_SERVICE_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/********************** macros ***********************************************/
+/* One-shot & periodic software timers on TIM2 (1 uS counts, not usable as a
+ * KIND_LED_XX_TIM actuator timer): a pending list sorted by deadline, channel 1
+ * compares on the earliest one, the update interrupt extends the 16-bit counter.
+ * Callbacks run in TIM2_IRQHandler() (stm32f1xx_it.c): short, no blocking, they may
+ * add & cancel timers. Delays & periods up to 2^31 uS. Non blocking replacement of
+ * systick_delay_us() for sub-millisecond waits (pulse widths, settle times).
+ * e.g.
+ *  static void sensor_settled(void *p_arg) { put_event_task_sensor(...); }
+ *  id = timer_service_add(150, 0, sensor_settled, NULL);	// once, in 150 uS
+ */
+#define TIMER_SERVICE_TIM			TIM2
+#define TIMER_SERVICE_IRQn			TIM2_IRQn
+#define TIMER_SERVICE_IRQ_PRIO		(2ul)
+#define TIMER_SERVICE_CNT_HZ		(1000000ul)
+
+#define TIMER_SERVICE_QTY			(16ul)
+#define TIMER_SERVICE_NONE			(0xFFul)	/* no timer (id) */
+
+/********************** typedef **********************************************/
+typedef void (*timer_service_cb_t)(void *p_arg);
+
+/* Callback lateness (deadline to callback) & interrupt cost (DWT cycles) */
+typedef struct
+{
+	uint32_t	fired;
+	uint32_t	pending_max;
+	uint32_t	late_us_max;
+	uint32_t	isr_cycles_max;
+} timer_service_stats_t;
+
+/********************** external data declaration ****************************/
+extern timer_service_stats_t timer_service_stats;
+
+/********************** external functions declaration ***********************/
+void timer_service_init(void);
+
+/* Microseconds (32-bit, wraps every 71 minutes) */
+uint32_t timer_service_now_us(void);
+
+/* Timer firing in "delay_us", then every "period_us" (0 => one-shot). Returns its id,
+ * TIMER_SERVICE_NONE when all are in use. A one-shot id is free once it fired. */
+uint32_t timer_service_add(uint32_t delay_us, uint32_t period_us, timer_service_cb_t callback, void *p_arg);
+void timer_service_cancel(uint32_t id);
+
+/* Timers waiting */
+uint32_t timer_service_pending(void);
+
+/* TIM2_IRQHandler() */
+void timer_service_isr(void);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TIMER_SERVICE_INC_TIMER_SERVICE_H_ */
+
+/********************** end of file ******************************************/
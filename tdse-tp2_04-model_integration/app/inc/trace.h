@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : trace.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef TRACE_INC_TRACE_H_
+#define TRACE_INC_TRACE_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+
+/********************** macros ***********************************************/
+/* Execution trace: 8-byte records (CYCCNT stamp, type, id, argument) in a wrapping
+ * ring, written from tasks & ISRs (LDREX/STREX reservation, stamp taken inside it:
+ * ring order == time order). trace_trigger() freezes it, trace_dump_update() (idle)
+ * streams it through the USART2 TX ring as "#T" text lines, trace recording starts
+ * again once dumped. tools/trace_to_chrome.py => Chrome trace-event JSON (Perfetto).
+ * dwt.h must be included before this file. 0 == TRACE_CONFIG_ENABLE compiles every
+ * hook out (benches). */
+#ifndef TRACE_CONFIG_ENABLE
+#define TRACE_CONFIG_ENABLE			(1)
+#endif
+#define TRACE_CONFIG_QTY			(256ul)		/* records, power of 2 (2 KB) */
+
+/* TRACE_STATE() & the actuator events pack instance << 8 | value in the 16-bit
+ * argument: instances up to 256, asserted by the statecharts tracing them */
+#define TRACE_INSTANCE_QTY_MAX		(256ul)
+
+/* Exclusive access: LDREX/STREX on Cortex-M3, GCC atomics on host builds */
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define TRACE_LDREX_(p)				__LDREXW(p)
+#define TRACE_STREX_(old, v, p)		__STREXW((v), (p))
+#else
+#define TRACE_LDREX_(p)				__atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define TRACE_STREX_(old, v, p)		((uint32_t)!__atomic_compare_exchange_n((p), &(old), (v), false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+#endif
+
+#if 1 == TRACE_CONFIG_ENABLE
+#define TRACE_TASK_BEGIN(task)		trace_put(TRACE_TYPE_TASK_BEGIN, (task), 0)
+#define TRACE_TASK_END(task)		trace_put(TRACE_TYPE_TASK_END, (task), 0)
+#define TRACE_ISR_ENTER(isr)		trace_put(TRACE_TYPE_ISR_ENTER, (isr), 0)
+#define TRACE_ISR_EXIT(isr)			trace_put(TRACE_TYPE_ISR_EXIT, (isr), 0)
+#define TRACE_EVENT_PUT(queue, ev)	trace_put(TRACE_TYPE_EVENT_PUT, (queue), (ev))
+#define TRACE_EVENT_GET(queue, ev)	trace_put(TRACE_TYPE_EVENT_GET, (queue), (ev))
+
+/* State machine "fsm", instance "index": recorded only when "old" != "new" */
+#define TRACE_STATE(fsm, index, old, new)\
+	do\
+	{\
+		if ((old) != (new))\
+		{\
+			trace_put(TRACE_TYPE_STATE, (fsm), ((uint32_t)(index) << 8) | (uint32_t)(new));\
+		}\
+	} while (0)
+#else
+#define TRACE_TASK_BEGIN(task)
+#define TRACE_TASK_END(task)
+#define TRACE_ISR_ENTER(isr)
+#define TRACE_ISR_EXIT(isr)
+#define TRACE_EVENT_PUT(queue, ev)	((void)(ev))
+#define TRACE_EVENT_GET(queue, ev)	((void)(ev))
+#define TRACE_STATE(fsm, index, old, new)	((void)(old))
+#endif
+
+/********************** typedef **********************************************/
+/* Ids below are the ones tools/trace_to_chrome.py names */
+typedef enum
+{
+	TRACE_TYPE_TASK_BEGIN,		/* id: task index (task_cfg_list[], app.c) */
+	TRACE_TYPE_TASK_END,
+	TRACE_TYPE_ISR_ENTER,		/* id: trace_isr_t */
+	TRACE_TYPE_ISR_EXIT,
+	TRACE_TYPE_EVENT_PUT,		/* id: trace_queue_t, argument: event */
+	TRACE_TYPE_EVENT_GET,
+	TRACE_TYPE_STATE,			/* id: trace_fsm_t, argument: instance << 8 | new state */
+	TRACE_TYPE_QTY
+} trace_type_t;
+
+typedef enum
+{
+	TRACE_ISR_SYSTICK,
+	TRACE_ISR_EXTI15_10,
+	TRACE_ISR_TIM4,
+	TRACE_ISR_DMA1_CH7,
+	TRACE_ISR_TIM2,
+	TRACE_ISR_DMA1_CH6,
+	TRACE_ISR_USART2,
+	TRACE_ISR_QTY
+} trace_isr_t;
+
+typedef enum
+{
+	TRACE_QUEUE_SYSTEM,
+	TRACE_QUEUE_ACTUATOR,
+	TRACE_QUEUE_QTY
+} trace_queue_t;
+
+typedef enum
+{
+	TRACE_FSM_SENSOR,
+	TRACE_FSM_GESTURE,
+	TRACE_FSM_SYSTEM,
+	TRACE_FSM_ACTUATOR,
+	TRACE_FSM_QTY
+} trace_fsm_t;
+
+typedef struct
+{
+	uint32_t	stamp;		/* CYCCNT */
+	uint8_t		type;
+	uint8_t		id;
+	uint16_t	arg;
+} trace_record_t;
+
+/********************** external data declaration ****************************/
+extern trace_record_t trace_buffer[TRACE_CONFIG_QTY];
+extern volatile uint32_t trace_head;
+extern volatile bool trace_enabled;
+
+/* record, wait-free from tasks & ISRs of any priority */
+static inline void trace_put(uint32_t type, uint32_t id, uint32_t arg) __attribute__((always_inline));
+static inline void trace_put(uint32_t type, uint32_t id, uint32_t arg)
+{
+	trace_record_t *p_record;
+	uint32_t head;
+	uint32_t stamp;
+
+	if (false == trace_enabled)
+	{
+		return;
+	}
+
+	do
+	{
+		head = TRACE_LDREX_(&trace_head);
+		stamp = cycle_counter_get();
+	} while (0 != TRACE_STREX_(head, head + 1, &trace_head));
+
+	p_record = &trace_buffer[head & (TRACE_CONFIG_QTY - 1)];
+	p_record->stamp = stamp;
+	p_record->type = (uint8_t)type;
+	p_record->id = (uint8_t)id;
+	p_record->arg = (uint16_t)arg;
+}
+
+/********************** external functions declaration ***********************/
+void trace_init(void);
+
+/* Freeze the ring & dump it (no-op while a dump is running) */
+void trace_trigger(void);
+
+/* Idle: stream the frozen ring as text lines, restart recording when done */
+void trace_dump_update(void);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_INC_TRACE_H_ */
+
+/********************** end of file ******************************************/
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : uart_dma_rx.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef UART_DMA_RX_INC_UART_DMA_RX_H_
+#define UART_DMA_RX_INC_UART_DMA_RX_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/********************** macros ***********************************************/
+/* USART2 RX (huart2) through DMA1 channel 6 into a circular ring: the DMA never
+ * stops, the half & full transfer interrupts and the USART idle-line interrupt
+ * (end of a burst) publish the bytes received, the reader polls the ring */
+#define UART_DMA_RX_USART			USART2
+#define UART_DMA_RX_CHANNEL			DMA1_Channel6
+#define UART_DMA_RX_DMA_IRQn		DMA1_Channel6_IRQn
+#define UART_DMA_RX_USART_IRQn		USART2_IRQn
+#define UART_DMA_RX_IRQ_PRIO		(14ul)	/* as the TX side, just above SysTick */
+
+#define UART_DMA_RX_RING_SIZE		(64ul)	/* bytes, power of 2 */
+
+/********************** typedef **********************************************/
+/* Overrun: bytes overwritten by the DMA before being read */
+typedef struct
+{
+	uint32_t	bytes;
+	uint32_t	idle;
+	uint32_t	overrun;
+	uint32_t	isr_cycles;
+} uart_dma_rx_stats_t;
+
+/********************** external data declaration ****************************/
+extern uart_dma_rx_stats_t uart_dma_rx_stats;
+
+/********************** external functions declaration ***********************/
+void uart_dma_rx_init(void);
+
+/* Bytes received & not read yet */
+uint32_t uart_dma_rx_available(void);
+
+/* Read up to "len" bytes (single consumer, task context), returns the bytes read */
+uint32_t uart_dma_rx_read(char *p_data, uint32_t len);
+
+/* DMA1_Channel6_IRQHandler() & USART2_IRQHandler() */
+void uart_dma_rx_isr(void);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UART_DMA_RX_INC_UART_DMA_RX_H_ */
+
+/********************** end of file ******************************************/
@@ -0,0 +1,105 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : uart_dma_tx.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+#ifndef UART_DMA_TX_INC_UART_DMA_TX_H_
+#define UART_DMA_TX_INC_UART_DMA_TX_H_
+
+/********************** CPP guard ********************************************/
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/********************** inclusions *******************************************/
+
+/********************** macros ***********************************************/
+/* USART2 TX (huart2, 115200 8N1 => 11520 bytes/S max.) through DMA1 channel 7 */
+#define UART_DMA_TX_USART			USART2
+#define UART_DMA_TX_CHANNEL			DMA1_Channel7
+#define UART_DMA_TX_IRQn			DMA1_Channel7_IRQn
+#define UART_DMA_TX_IRQ_PRIO		(14ul)	/* just above SysTick */
+
+#define UART_DMA_TX_RING_SIZE		(512ul)	/* bytes, power of 2 */
+
+/********************** typedef **********************************************/
+/* Transport counters: bytes/S = bytes_out * 1000 / busy_ms,
+ * CPU cycles/byte = (write_cycles + isr_cycles) / bytes_out */
+typedef struct
+{
+	uint32_t	bytes_in;
+	uint32_t	bytes_out;
+	uint32_t	dropped;
+	uint32_t	chunks;
+	uint32_t	busy_ms;
+	uint32_t	write_cycles;
+	uint32_t	isr_cycles;
+	uint32_t	level_max;
+} uart_dma_tx_stats_t;
+
+/********************** external data declaration ****************************/
+extern uart_dma_tx_stats_t uart_dma_tx_stats;
+
+/********************** external functions declaration ***********************/
+void uart_dma_tx_init(void);
+
+/* Enqueue bytes (single producer, task context), returns the bytes accepted */
+uint32_t uart_dma_tx_write(const char *p_data, uint32_t len);
+
+/* Reserve/commit (single producer): uart_dma_tx_reserve() returns the free bytes,
+ * uart_dma_tx_put() writes at an offset from the head, uart_dma_tx_commit() hands
+ * "len" bytes to the DMA, uart_dma_tx_abort() counts "len" bytes as dropped */
+uint32_t uart_dma_tx_reserve(void);
+void uart_dma_tx_put(uint32_t offset, char data);
+void uart_dma_tx_commit(uint32_t len);
+void uart_dma_tx_abort(uint32_t len);
+
+/* Blocking write of one byte (TXE polling), bypasses the ring: fault handlers */
+void uart_dma_tx_poll_put(char data);
+
+/* Free space in the TX ring */
+uint32_t uart_dma_tx_free(void);
+
+/* DMA1_Channel7_IRQHandler(): half & full transfer chaining */
+void uart_dma_tx_isr(void);
+
+/********************** End of CPP guard *************************************/
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* UART_DMA_TX_INC_UART_DMA_TX_H_ */
+
+/********************** end of file ******************************************/
@@ -42,6 +42,17 @@
 /* Demo includes */
 #include "logger.h"
 #include "dwt.h"
+#include "systick.h"
+#include "profiler.h"
+#include "cpu_load.h"
+#include "stack_monitor.h"
+#include "latency.h"
+#include "e2e_latency.h"
+#include "timer_service.h"
+#include "trace.h"
+#include "uart_dma_tx.h"
+#include "uart_dma_rx.h"
+#include "shell.h"
 
 /* Application & Tasks includes */
 #include "board.h"
@@ -96,20 +107,41 @@ void app_init(void)
 {
 	uint32_t index;
 
+	/* Stack & heap high-water from the regions painted at reset */
+	stack_monitor_init();
+
+	/* Init Cycle Counter: free running from here on, log records are stamped with it */
+	cycle_counter_init();
+	profiler_init();
+	trace_init();
+	cpu_load_init();
+	latency_init();
+	e2e_init();
+
+	/* Logger transport: USART2 TX through DMA, semihosting only with a debugger */
+	uart_dma_tx_init();
+	logger_sink_select();
+
+	/* Diagnostic shell: USART2 RX through DMA, idle-line detection */
+	uart_dma_rx_init();
+	shell_init();
+
+	/* One-shot & periodic uS timers (TIM2), before the tasks may use them */
+	timer_service_init();
+
 	/* Print out: Application Initialized */
 	LOGGER_INFO(" ");
 	LOGGER_INFO("%s is running - Tick [mS] = %lu", GET_NAME(app_init), HAL_GetTick());
 
-	LOGGER_INFO(p_sys);
-	LOGGER_INFO(p_app);
+	LOGGER_INFO("%s", p_sys);
+	LOGGER_INFO("%s", p_app);
+	LOGGER_INFO(" %s = %lu (%s)", GET_NAME(logger_sink), (uint32_t)logger_sink_get(),
+				(true == logger_debugger_attached()) ? "debugger" : "no debugger");
 
 	/* Init & Print out: Application execution counter */
 	g_app_cnt = G_APP_CNT_INI;
 	LOGGER_INFO(" %s = %lu", GET_NAME(g_app_cnt), g_app_cnt);
 
-	/* Init Cycle Counter */
-	cycle_counter_init();
-
     /* Go through the task arrays */
 	for (index = 0; TASK_QTY > index; index++)
 	{
@@ -136,6 +168,8 @@ void app_update(void)
 	uint32_t index;
 	bool b_time_update_required = false;
 	uint32_t cycle_counter_time_us;
+	uint32_t cycle_counter;
+	uint32_t isr_cycles;
 
 	/* Protect shared resource */
 	__asm("CPSID i");	/* disable interrupts */
@@ -154,15 +188,29 @@ void app_update(void)
     	g_app_cnt++;
     	g_app_runtime_us = 0;
 
+    	PROFILER_START(PROFILER_PROBE_APP_TICK);
+
+		/* SysTick => task_sensor_update() latency & release jitter */
+		LATENCY_TASK_RELEASE();
+
 		/* Go through the task arrays */
 		for (index = 0; TASK_QTY > index; index++)
 		{
-			cycle_counter_reset();
+			/* CYCCNT is never reset: 64-bit stamps & nested measurements use it */
+			isr_cycles = cpu_load_isr_cycles;
+			cycle_counter = cycle_counter_get();
 
     		/* Run task_x_update */
+			TRACE_TASK_BEGIN(index);
+			E2E_TASK_BEGIN();
 			(*task_cfg_list[index].task_update)(task_cfg_list[index].parameters);
+			TRACE_TASK_END(index);
+
+			cycle_counter = cycle_counter_get() - cycle_counter;
+			PROFILER_ADD(PROFILER_PROBE_TASK_SENSOR + index, cycle_counter);
+			cpu_load_task_add(index, cycle_counter - (cpu_load_isr_cycles - isr_cycles));
 
-			cycle_counter_time_us = cycle_counter_get_time_us();
+			cycle_counter_time_us = cycle_counter_to_us(cycle_counter);
 
 			/* Update variables */
 			g_app_runtime_us += cycle_counter_time_us;
@@ -173,6 +221,17 @@ void app_update(void)
 			}
 		}
 
+		PROFILER_STOP(PROFILER_PROBE_APP_TICK);
+
+		/* Tick overrun: freeze the trace around it & dump it from idle */
+		if (1000ul < g_app_runtime_us)
+		{
+			trace_trigger();
+		}
+
+		/* CPU load: closes the second when due */
+		cpu_load_update();
+
 		/* Protect shared resource */
 		__asm("CPSID i");	/* disable interrupts */
 		if (G_APP_TICK_CNT_INI < g_app_tick_cnt)
@@ -187,10 +246,48 @@ void app_update(void)
 		}
 		__asm("CPSIE i");	/* enable interrupts */
 	}
+
+	/* Idle: format & print deferred log records, profiled when there were some */
+	PROFILER_START(PROFILER_PROBE_LOGGER_DRAIN);
+	if (0 < logger_drain(LOGGER_CONFIG_DRAIN_QTY))
+	{
+		PROFILER_STOP(PROFILER_PROBE_LOGGER_DRAIN);
+	}
+
+	trace_dump_update();
+	stack_monitor_update();
+
+	/* Diagnostic shell: a few received bytes, at most one command */
+	shell_update();
+}
+
+void app_dump(void)
+{
+	uint32_t index;
+
+	LOGGER_INFO("app: cnt %lu runtime %lu uS (last tick)", g_app_cnt, g_app_runtime_us);
+	for (index = 0; TASK_QTY > index; index++)
+	{
+		LOGGER_INFO(" task %lu wcet %lu uS", index, task_dta_list[index].WCET);
+	}
+}
+
+void app_wcet_reset(void)
+{
+	uint32_t index;
+
+	for (index = 0; TASK_QTY > index; index++)
+	{
+		task_dta_list[index].WCET = TASK_X_WCET_INI;
+	}
 }
 
 void HAL_SYSTICK_Callback(void)
 {
+	/* Extend the cycle counter & the tick to 64-bit */
+	cycle_counter_extend();
+	systick_extend();
+
 	/* Update Tick Counter */
 	g_app_tick_cnt++;
 
@@ -199,4 +296,10 @@ void HAL_SYSTICK_Callback(void)
 	g_task_actuator_tick_cnt++;
 }
 
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+	/* Wake up the sensors on this EXTI line */
+	task_sensor_wakeup(GPIO_Pin);
+}
+
 /********************** end of file ******************************************/
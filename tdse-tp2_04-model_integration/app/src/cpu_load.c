@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : cpu_load.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+/********************** inclusions *******************************************/
+/* Project includes */
+#include "main.h"
+
+/* Demo includes */
+#include "logger.h"
+#include "dwt.h"
+#include "cpu_load.h"
+
+/********************** macros and definitions *******************************/
+#define CPU_LOAD_PM					(1000ul)
+
+/* cpu_load_pm_t walked as an array of per mille fields */
+#define CPU_LOAD_FIELD_QTY			(sizeof(cpu_load_pm_t) / sizeof(uint16_t))
+
+/********************** internal data declaration ****************************/
+typedef struct
+{
+	uint32_t	start;							/* CYCCNT at the window start */
+	uint32_t	isr_start;						/* cpu_load_isr_cycles at the window start */
+	uint32_t	task[CPU_LOAD_CONFIG_TASK_QTY];	/* task cycles in the window */
+} cpu_load_window_t;
+
+/********************** internal functions declaration ***********************/
+static uint16_t cpu_load_pm_(uint32_t cycles, uint32_t window_pm);
+
+/********************** internal data definition *****************************/
+static cpu_load_window_t cpu_load_window_;
+static cpu_load_t cpu_load_;
+
+/* Rolling minute: one entry per second & the running sum of each field */
+static cpu_load_pm_t cpu_load_minute_list_[CPU_LOAD_CONFIG_MINUTE_QTY];
+static uint32_t cpu_load_minute_sum_[CPU_LOAD_FIELD_QTY];
+static uint32_t cpu_load_minute_index_;
+
+/********************** external data declaration ****************************/
+volatile uint32_t cpu_load_isr_cycles;
+volatile uint32_t cpu_load_isr_depth;
+volatile uint32_t cpu_load_isr_start;
+
+/********************** internal functions definition ************************/
+static uint16_t cpu_load_pm_(uint32_t cycles, uint32_t window_pm)
+{
+	cycles /= window_pm;
+
+	return (uint16_t)((CPU_LOAD_PM < cycles) ? CPU_LOAD_PM : cycles);
+}
+
+/********************** external functions definition ************************/
+void cpu_load_init(void)
+{
+	cpu_load_isr_depth = 0;
+	cpu_load_reset();
+}
+
+void cpu_load_reset(void)
+{
+	memset(&cpu_load_window_, 0, sizeof(cpu_load_window_));
+	memset(&cpu_load_, 0, sizeof(cpu_load_));
+	memset(cpu_load_minute_list_, 0, sizeof(cpu_load_minute_list_));
+	memset(cpu_load_minute_sum_, 0, sizeof(cpu_load_minute_sum_));
+	cpu_load_minute_index_ = 0;
+
+	cpu_load_window_.start = cycle_counter_get();
+	cpu_load_window_.isr_start = cpu_load_isr_cycles;
+}
+
+void cpu_load_task_add(uint32_t task, uint32_t cycles)
+{
+	if (CPU_LOAD_CONFIG_TASK_QTY > task)
+	{
+		cpu_load_window_.task[task] += cycles;
+	}
+}
+
+void cpu_load_update(void)
+{
+	cpu_load_pm_t *p_second;
+	uint16_t *p_field;
+	uint16_t *p_old;
+	uint32_t now;
+	uint32_t window;
+	uint32_t window_pm;
+	uint32_t busy;
+	uint32_t index;
+	uint32_t qty;
+
+	now = cycle_counter_get();
+	window = now - cpu_load_window_.start;
+	if (SystemCoreClock > window)
+	{
+		return;
+	}
+
+	/* Close the second: one divide per field, once per second */
+	p_second = &cpu_load_.second;
+	window_pm = window / CPU_LOAD_PM;
+
+	busy = cpu_load_isr_cycles - cpu_load_window_.isr_start;
+	p_second->isr = cpu_load_pm_(busy, window_pm);
+	for (index = 0; CPU_LOAD_CONFIG_TASK_QTY > index; index++)
+	{
+		p_second->task[index] = cpu_load_pm_(cpu_load_window_.task[index], window_pm);
+		busy += cpu_load_window_.task[index];
+		cpu_load_window_.task[index] = 0;
+	}
+	p_second->load = cpu_load_pm_(busy, window_pm);
+	p_second->idle = (uint16_t)(CPU_LOAD_PM - p_second->load);
+
+	cpu_load_window_.start = now;
+	cpu_load_window_.isr_start = cpu_load_isr_cycles;
+
+	if (cpu_load_.load_max < p_second->load)
+	{
+		cpu_load_.load_max = p_second->load;
+	}
+	cpu_load_.seconds++;
+
+	/* Rolling minute: replace the oldest second in the running sums */
+	p_field = (uint16_t *)p_second;
+	p_old = (uint16_t *)&cpu_load_minute_list_[cpu_load_minute_index_];
+	for (index = 0; CPU_LOAD_FIELD_QTY > index; index++)
+	{
+		cpu_load_minute_sum_[index] += (uint32_t)p_field[index] - p_old[index];
+		p_old[index] = p_field[index];
+	}
+	cpu_load_minute_index_ = (cpu_load_minute_index_ + 1) % CPU_LOAD_CONFIG_MINUTE_QTY;
+
+	qty = (CPU_LOAD_CONFIG_MINUTE_QTY < cpu_load_.seconds) ? CPU_LOAD_CONFIG_MINUTE_QTY : cpu_load_.seconds;
+	p_field = (uint16_t *)&cpu_load_.minute;
+	for (index = 0; CPU_LOAD_FIELD_QTY > index; index++)
+	{
+		p_field[index] = (uint16_t)(cpu_load_minute_sum_[index] / qty);
+	}
+
+#if 0 < CPU_LOAD_CONFIG_TELEMETRY_S
+	if (0 == (cpu_load_.seconds % CPU_LOAD_CONFIG_TELEMETRY_S))
+	{
+		LOGGER_INFO("cpu: load %lu (1 min %lu, max %lu) isr %lu idle %lu o/oo",
+					(uint32_t)p_second->load, (uint32_t)cpu_load_.minute.load,
+					(uint32_t)cpu_load_.load_max, (uint32_t)p_second->isr, (uint32_t)p_second->idle);
+		LOGGER_INFO("cpu: tasks %lu %lu %lu o/oo", (uint32_t)p_second->task[0],
+					(uint32_t)p_second->task[1], (uint32_t)p_second->task[2]);
+	}
+#endif
+}
+
+void cpu_load_get(cpu_load_t *p_cpu_load)
+{
+	*p_cpu_load = cpu_load_;
+}
+
+/********************** end of file ******************************************/
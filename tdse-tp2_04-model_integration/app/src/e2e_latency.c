@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : e2e_latency.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+/********************** inclusions *******************************************/
+/* Project includes */
+#include "main.h"
+
+/* Demo includes */
+#include "logger.h"
+#include "dwt.h"
+#include "latency.h"
+#include "e2e_latency.h"
+
+/********************** macros and definitions *******************************/
+#define E2E_PATH_(sys_ev, act_ev)	((uint8_t)((((sys_ev) & 0x0Fu) << 4) | ((act_ev) & 0x0Fu)))
+
+/********************** internal data declaration ****************************/
+
+/********************** internal functions declaration ***********************/
+static uint32_t e2e_path_index_(uint8_t path);
+
+/********************** internal data definition *****************************/
+static const char * const e2e_hop_name_[E2E_HOP_QTY] =
+{
+	[E2E_HOP_SENSOR]	= "sensor",
+	[E2E_HOP_QUEUE]		= "queue",
+	[E2E_HOP_SYSTEM]	= "system",
+	[E2E_HOP_ACTUATOR]	= "actuator",
+	[E2E_HOP_OUTPUT]	= "output",
+};
+
+/* Armed by EXTI (task_sensor_wakeup()) or task_sensor, cleared by task_sensor */
+static volatile uint32_t e2e_sensor_origin_[E2E_CONFIG_SENSOR_QTY];
+static volatile bool e2e_sensor_armed_[E2E_CONFIG_SENSOR_QTY];
+
+/* Event in hand of the running task */
+static e2e_stamp_t e2e_current_;
+
+/* Task actuator mailboxes, taken ones waiting for the GPIO commit */
+static e2e_stamp_t e2e_actuator_[E2E_CONFIG_ACTUATOR_QTY];
+static uint32_t e2e_actuator_taken_;
+
+static uint32_t e2e_path_qty_;
+
+/********************** external data declaration ****************************/
+latency_dta_t e2e_hop_dta_list[E2E_HOP_QTY];
+latency_dta_t e2e_path_dta_list[E2E_CONFIG_PATH_QTY];
+uint8_t e2e_path_list[E2E_CONFIG_PATH_QTY];
+
+/********************** internal functions definition ************************/
+/* Slot of a path, allocated at first sight, the last one takes the rest */
+static uint32_t e2e_path_index_(uint8_t path)
+{
+	uint32_t index;
+
+	for (index = 0; e2e_path_qty_ > index; index++)
+	{
+		if (path == e2e_path_list[index])
+		{
+			return index;
+		}
+	}
+
+	if (E2E_CONFIG_PATH_QTY > e2e_path_qty_)
+	{
+		e2e_path_list[e2e_path_qty_] = path;
+		return e2e_path_qty_++;
+	}
+
+	index = E2E_CONFIG_PATH_QTY - 1;
+	e2e_path_list[index] = E2E_PATH_MIXED;
+	return index;
+}
+
+/********************** external functions definition ************************/
+void e2e_init(void)
+{
+	memset((void *)e2e_sensor_armed_, 0, sizeof(e2e_sensor_armed_));
+	memset(e2e_actuator_, 0, sizeof(e2e_actuator_));
+	e2e_actuator_taken_ = 0;
+	e2e_current_.valid = false;
+	e2e_reset();
+}
+
+void e2e_reset(void)
+{
+	uint32_t index;
+
+	memset(e2e_hop_dta_list, 0, sizeof(e2e_hop_dta_list));
+	for (index = 0; E2E_HOP_QTY > index; index++)
+	{
+		e2e_hop_dta_list[index].min = UINT32_MAX;
+	}
+
+	memset(e2e_path_dta_list, 0, sizeof(e2e_path_dta_list));
+	for (index = 0; E2E_CONFIG_PATH_QTY > index; index++)
+	{
+		e2e_path_dta_list[index].min = UINT32_MAX;
+	}
+	e2e_path_qty_ = 0;
+}
+
+void e2e_task_begin(void)
+{
+	e2e_current_.valid = false;
+}
+
+void e2e_sensor_arm(uint32_t sensor)
+{
+	/* First edge only: bounces keep the origin */
+	if ((E2E_CONFIG_SENSOR_QTY > sensor) && (false == e2e_sensor_armed_[sensor]))
+	{
+		e2e_sensor_origin_[sensor] = cycle_counter_get();
+		e2e_sensor_armed_[sensor] = true;
+	}
+}
+
+void e2e_sensor_emit(uint32_t sensor)
+{
+	e2e_current_.origin = cycle_counter_get();
+	e2e_current_.valid = true;
+
+	if ((E2E_CONFIG_SENSOR_QTY > sensor) && (true == e2e_sensor_armed_[sensor]))
+	{
+		e2e_current_.origin = e2e_sensor_origin_[sensor];
+		e2e_sensor_armed_[sensor] = false;
+	}
+}
+
+void e2e_sensor_disarm(uint32_t sensor)
+{
+	if (E2E_CONFIG_SENSOR_QTY > sensor)
+	{
+		e2e_sensor_armed_[sensor] = false;
+	}
+}
+
+void e2e_origin_now(void)
+{
+	e2e_current_.origin = cycle_counter_get();
+	e2e_current_.valid = true;
+}
+
+void e2e_put(e2e_stamp_t *p_stamp, uint32_t event)
+{
+	uint32_t stamp = cycle_counter_get();
+
+	*p_stamp = e2e_current_;
+	if (true == e2e_current_.valid)
+	{
+		latency_add(&e2e_hop_dta_list[E2E_HOP_SENSOR], stamp - e2e_current_.origin);
+		p_stamp->hop = stamp;
+		p_stamp->path = E2E_PATH_(event, 0);
+	}
+}
+
+void e2e_get(const e2e_stamp_t *p_stamp)
+{
+	uint32_t stamp = cycle_counter_get();
+
+	e2e_current_ = *p_stamp;
+	if (true == e2e_current_.valid)
+	{
+		latency_add(&e2e_hop_dta_list[E2E_HOP_QUEUE], stamp - e2e_current_.hop);
+		e2e_current_.hop = stamp;
+	}
+}
+
+void e2e_actuator_put(uint32_t index, uint32_t event)
+{
+	uint32_t stamp = cycle_counter_get();
+	e2e_stamp_t *p_stamp;
+
+	if (E2E_CONFIG_ACTUATOR_QTY <= index)
+	{
+		return;
+	}
+
+	/* A posted event replaces the one in the mailbox */
+	p_stamp = &e2e_actuator_[index];
+	*p_stamp = e2e_current_;
+	e2e_actuator_taken_ &= ~(1ul << index);
+	if (true == e2e_current_.valid)
+	{
+		latency_add(&e2e_hop_dta_list[E2E_HOP_SYSTEM], stamp - e2e_current_.hop);
+		p_stamp->hop = stamp;
+		p_stamp->path = E2E_PATH_(e2e_current_.path >> 4, event);
+	}
+}
+
+void e2e_actuator_take(uint32_t index)
+{
+	uint32_t stamp = cycle_counter_get();
+	e2e_stamp_t *p_stamp;
+
+	if (E2E_CONFIG_ACTUATOR_QTY <= index)
+	{
+		return;
+	}
+
+	p_stamp = &e2e_actuator_[index];
+	if (true == p_stamp->valid)
+	{
+		latency_add(&e2e_hop_dta_list[E2E_HOP_ACTUATOR], stamp - p_stamp->hop);
+		p_stamp->hop = stamp;
+		e2e_actuator_taken_ |= (1ul << index);
+	}
+}
+
+void e2e_output(void)
+{
+	uint32_t stamp = cycle_counter_get();
+	uint32_t taken = e2e_actuator_taken_;
+	uint32_t index;
+	e2e_stamp_t *p_stamp;
+
+	e2e_actuator_taken_ = 0;
+	while (0 != taken)
+	{
+		index = (uint32_t)__builtin_ctz(taken);
+		taken &= taken - 1;
+
+		p_stamp = &e2e_actuator_[index];
+		latency_add(&e2e_hop_dta_list[E2E_HOP_OUTPUT], stamp - p_stamp->hop);
+		latency_add(&e2e_path_dta_list[e2e_path_index_(p_stamp->path)], stamp - p_stamp->origin);
+		p_stamp->valid = false;
+	}
+}
+
+void e2e_dump(void)
+{
+	latency_stat_t stat;
+	uint32_t index;
+
+	LOGGER_INFO("e2e: uS");
+
+	for (index = 0; E2E_HOP_QTY > index; index++)
+	{
+		latency_stat(&e2e_hop_dta_list[index], &stat);
+		if (0 == stat.count)
+		{
+			continue;
+		}
+
+		LOGGER_INFO(" hop %s n %lu min %lu p50 %lu p99 %lu max %lu", e2e_hop_name_[index], stat.count,
+					cycle_counter_to_us(stat.min), cycle_counter_to_us(stat.p50),
+					cycle_counter_to_us(stat.p99), cycle_counter_to_us(stat.max));
+	}
+
+	for (index = 0; e2e_path_qty_ > index; index++)
+	{
+		latency_stat(&e2e_path_dta_list[index], &stat);
+		if (0 == stat.count)
+		{
+			continue;
+		}
+
+		if (E2E_PATH_MIXED == e2e_path_list[index])
+		{
+			LOGGER_INFO(" path other n %lu min %lu p50 %lu p99 %lu max %lu", stat.count,
+						cycle_counter_to_us(stat.min), cycle_counter_to_us(stat.p50),
+						cycle_counter_to_us(stat.p99), cycle_counter_to_us(stat.max));
+			continue;
+		}
+
+		LOGGER_INFO(" path sys %u act %u n %lu min %lu p50 %lu p99 %lu max %lu",
+					(unsigned int)(e2e_path_list[index] >> 4), (unsigned int)(e2e_path_list[index] & 0x0Fu),
+					stat.count, cycle_counter_to_us(stat.min), cycle_counter_to_us(stat.p50),
+					cycle_counter_to_us(stat.p99), cycle_counter_to_us(stat.max));
+	}
+}
+
+/********************** end of file ******************************************/
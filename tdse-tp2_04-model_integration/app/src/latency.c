@@ -0,0 +1,298 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : latency.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+/********************** inclusions *******************************************/
+/* Project includes */
+#include "main.h"
+
+/* Demo includes */
+#include "logger.h"
+#include "dwt.h"
+#include "latency.h"
+
+/********************** macros and definitions *******************************/
+#define LATENCY_SUB_MASK_		((1ul << LATENCY_HIST_SUB) - 1)
+#define LATENCY_BIN_MIN_		(1ul << LATENCY_HIST_SUB)	/* exact bins below */
+
+/********************** internal data declaration ****************************/
+
+/********************** internal functions declaration ***********************/
+static uint32_t latency_bin_(uint32_t cycles);
+static uint32_t latency_bin_value_(uint32_t bin);
+
+/********************** internal data definition *****************************/
+static const char * const latency_probe_name_[LATENCY_PROBE_QTY] =
+{
+	[LATENCY_PROBE_SYSTICK_ENTRY]	= "systick_entry",
+	[LATENCY_PROBE_TICK_RELEASE]	= "tick_release",
+	[LATENCY_PROBE_TICK_JITTER]		= "tick_jitter",
+	[LATENCY_PROBE_EXTI_OUTPUT]		= "exti_output",
+};
+
+static volatile uint32_t latency_systick_stamp_;
+static volatile uint32_t latency_exti_stamp_;
+static volatile bool latency_exti_pending_;
+
+static uint32_t latency_release_stamp_;
+static bool latency_release_valid_;
+static uint32_t latency_period_;			/* cycles per tick */
+static uint32_t latency_exti_timeout_;		/* cycles */
+
+/********************** external data declaration ****************************/
+latency_dta_t latency_dta_list[LATENCY_PROBE_QTY];
+
+/********************** internal functions definition ************************/
+/* Bin: octave (CLZ) & the next LATENCY_HIST_SUB bits below the leading one */
+static uint32_t latency_bin_(uint32_t cycles)
+{
+	uint32_t msb;
+
+	if (LATENCY_BIN_MIN_ > cycles)
+	{
+		return cycles;
+	}
+
+	msb = 31u - __CLZ(cycles);
+	return ((msb - LATENCY_HIST_SUB + 1) << LATENCY_HIST_SUB)
+		 + ((cycles >> (msb - LATENCY_HIST_SUB)) & LATENCY_SUB_MASK_);
+}
+
+/* Middle of a bin */
+static uint32_t latency_bin_value_(uint32_t bin)
+{
+	uint32_t shift;
+
+	if (LATENCY_BIN_MIN_ > bin)
+	{
+		return bin;
+	}
+
+	shift = (bin >> LATENCY_HIST_SUB) - 1;
+	return (((bin & LATENCY_SUB_MASK_) | LATENCY_BIN_MIN_) << shift) + ((1ul << shift) >> 1);
+}
+
+/********************** external functions definition ************************/
+void latency_init(void)
+{
+	latency_period_ = SystemCoreClock / 1000ul;
+	latency_exti_timeout_ = LATENCY_CONFIG_EXTI_TIMEOUT_MS * latency_period_;
+	latency_reset();
+}
+
+void latency_reset(void)
+{
+	uint32_t index;
+
+	memset(latency_dta_list, 0, sizeof(latency_dta_list));
+	for (index = 0; LATENCY_PROBE_QTY > index; index++)
+	{
+		latency_dta_list[index].min = UINT32_MAX;
+	}
+
+	latency_release_valid_ = false;
+	latency_exti_pending_ = false;
+}
+
+void latency_add(latency_dta_t *p_dta, uint32_t cycles)
+{
+	uint16_t *p_bin;
+	uint32_t index;
+
+	p_dta->count++;
+	if (p_dta->min > cycles)
+	{
+		p_dta->min = cycles;
+	}
+	if (p_dta->max < cycles)
+	{
+		p_dta->max = cycles;
+	}
+
+	p_bin = &p_dta->hist[latency_bin_(cycles)];
+	if (UINT16_MAX == *p_bin)
+	{
+		/* Keep the shape, lose the oldest weight */
+		for (index = 0; LATENCY_HIST_QTY > index; index++)
+		{
+			p_dta->hist[index] >>= 1;
+		}
+	}
+	(*p_bin)++;
+}
+
+void latency_systick_isr(void)
+{
+	uint32_t stamp = cycle_counter_get();
+
+	/* Cycles since the counter reloaded (SysTick clocked from HCLK) */
+	latency_add(&latency_dta_list[LATENCY_PROBE_SYSTICK_ENTRY], SysTick->LOAD - SysTick->VAL);
+	latency_systick_stamp_ = stamp;
+}
+
+void latency_exti_isr(void)
+{
+	/* First edge only: bounces & later edges wait for the output change */
+	if (false == latency_exti_pending_)
+	{
+		latency_exti_stamp_ = cycle_counter_get();
+		latency_exti_pending_ = true;
+	}
+}
+
+void latency_task_release(void)
+{
+	uint32_t stamp = cycle_counter_get();
+	uint32_t period;
+
+	latency_add(&latency_dta_list[LATENCY_PROBE_TICK_RELEASE], stamp - latency_systick_stamp_);
+
+	if (true == latency_release_valid_)
+	{
+		period = stamp - latency_release_stamp_;
+		latency_add(&latency_dta_list[LATENCY_PROBE_TICK_JITTER],
+					(period > latency_period_) ? (period - latency_period_) : (latency_period_ - period));
+	}
+	latency_release_stamp_ = stamp;
+	latency_release_valid_ = true;
+
+	/* Edge that changed no output */
+	if ((true == latency_exti_pending_) && (latency_exti_timeout_ < (stamp - latency_exti_stamp_)))
+	{
+		latency_exti_pending_ = false;
+	}
+}
+
+void latency_output(void)
+{
+	if (true == latency_exti_pending_)
+	{
+		latency_add(&latency_dta_list[LATENCY_PROBE_EXTI_OUTPUT], cycle_counter_get() - latency_exti_stamp_);
+		latency_exti_pending_ = false;
+	}
+}
+
+void latency_stat(const latency_dta_t *p_dta, latency_stat_t *p_stat)
+{
+	uint32_t total;
+	uint32_t sum;
+	uint32_t p50;
+	uint32_t p99;
+	uint32_t index;
+	bool b_p50 = false;
+
+	memset(p_stat, 0, sizeof(latency_stat_t));
+	p_stat->count = p_dta->count;
+	if (0 == p_dta->count)
+	{
+		return;
+	}
+	p_stat->min = p_dta->min;
+	p_stat->max = p_dta->max;
+	p_stat->p50 = p_dta->max;
+	p_stat->p99 = p_dta->max;
+
+	/* Ranks over the (possibly halved) histogram */
+	total = 0;
+	for (index = 0; LATENCY_HIST_QTY > index; index++)
+	{
+		total += p_dta->hist[index];
+	}
+	p50 = (total + 1) / 2;
+	p99 = total - (total / 100);
+
+	sum = 0;
+	for (index = 0; LATENCY_HIST_QTY > index; index++)
+	{
+		if (0 == p_dta->hist[index])
+		{
+			continue;
+		}
+
+		sum += p_dta->hist[index];
+		if ((false == b_p50) && (p50 <= sum))
+		{
+			p_stat->p50 = latency_bin_value_(index);
+			b_p50 = true;
+		}
+		if (p99 <= sum)
+		{
+			p_stat->p99 = latency_bin_value_(index);
+			break;
+		}
+	}
+
+	/* Bin middles stay inside the measured range */
+	if (p_stat->p50 < p_stat->min)
+	{
+		p_stat->p50 = p_stat->min;
+	}
+	if (p_stat->p99 > p_stat->max)
+	{
+		p_stat->p99 = p_stat->max;
+	}
+	if (p_stat->p50 > p_stat->p99)
+	{
+		p_stat->p50 = p_stat->p99;
+	}
+}
+
+void latency_get(latency_probe_t probe, latency_stat_t *p_stat)
+{
+	latency_stat(&latency_dta_list[probe], p_stat);
+}
+
+void latency_dump(void)
+{
+	latency_stat_t stat;
+	uint32_t index;
+
+	LOGGER_INFO("latency: cycles (%lu per uS)", cycle_counter_cycles_per_us);
+
+	for (index = 0; LATENCY_PROBE_QTY > index; index++)
+	{
+		latency_get((latency_probe_t)index, &stat);
+		if (0 == stat.count)
+		{
+			continue;
+		}
+
+		LOGGER_INFO(" %s n %lu min %lu p50 %lu p99 %lu max %lu", latency_probe_name_[index],
+					stat.count, stat.min, stat.p50, stat.p99, stat.max);
+	}
+}
+
+/********************** end of file ******************************************/
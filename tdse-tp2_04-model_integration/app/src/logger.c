@@ -45,38 +45,756 @@
 #include "main.h"
 
 #include "logger.h"
+#include "dwt.h"
+#include "uart_dma_tx.h"
 
 /********************** macros and definitions *******************************/
 
+#define LOGGER_RING_MASK_	(LOGGER_CONFIG_RING_QTY - 1)
+
+/* Exclusive access: LDREX/STREX on Cortex-M3, GCC atomics on host builds */
+#if defined(__ARM_ARCH_7M__) || defined(__ARM_ARCH_7EM__)
+#define LOGGER_LDREX_(p)			__LDREXW(p)
+#define LOGGER_STREX_(old, v, p)	__STREXW((v), (p))
+#define LOGGER_CLREX_()				__CLREX()
+#define LOGGER_DMB_()				__DMB()
+#else
+#define LOGGER_LDREX_(p)			__atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define LOGGER_STREX_(old, v, p)	((uint32_t)!__atomic_compare_exchange_n((p), &(old), (v), false, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED))
+#define LOGGER_CLREX_()
+#define LOGGER_DMB_()				__atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+/* Number conversion: sign & 32-bit decimal (10 digits) */
+#define LOGGER_DIGITS_MAX_	(11)
+
 /********************** internal data declaration ****************************/
 
+typedef struct
+{
+	uint64_t			stamp;		/* cycles, taken with the reservation */
+	const char *		fmt;
+	uint8_t				level;
+	uint8_t				argc;
+	volatile uint8_t	ready;		/* written last by the producer */
+	uintptr_t			arg[LOGGER_CONFIG_ARGS_MAX];
+} logger_record_t;
+
+/* Multi-producer (tasks & ISRs, LDREX/STREX reservation), single consumer (idle) */
+typedef struct
+{
+	volatile uint32_t	head;		/* next record to reserve, free running */
+	volatile uint32_t	tail;		/* next record to drain, free running */
+	logger_record_t		record[LOGGER_CONFIG_RING_QTY];
+} logger_ring_t;
+
+/* One line streamed into the transport: bytes past "room" are counted, not written.
+ * "capacity" is the most the sink can ever take: a longer line never fits */
+typedef struct logger_out_s logger_out_t;
+
+/* Sink operations */
+typedef struct
+{
+	void (*begin)(logger_out_t *p_out);
+	void (*put)(uint32_t offset, char c);
+	void (*end)(const logger_out_t *p_out);
+} logger_sink_cfg_t;
+
+struct logger_out_s
+{
+	const logger_sink_cfg_t *	p_sink;
+	uint32_t					len;
+	uint32_t					room;
+	uint32_t					capacity;
+};
+
 /********************** internal functions declaration ***********************/
 
+static void logger_sink_null_begin_(logger_out_t *p_out);
+static void logger_sink_null_put_(uint32_t offset, char c);
+static void logger_sink_null_end_(const logger_out_t *p_out);
+#if 1 == LOGGER_CONFIG_USE_UART
+static void logger_sink_uart_begin_(logger_out_t *p_out);
+static void logger_sink_uart_put_(uint32_t offset, char c);
+static void logger_sink_uart_end_(const logger_out_t *p_out);
+static void logger_sink_uart_poll_put_(uint32_t offset, char c);
+#endif
+#if 1 == LOGGER_CONFIG_USE_SEMIHOSTING
+static void logger_sink_semihosting_begin_(logger_out_t *p_out);
+static void logger_sink_semihosting_put_(uint32_t offset, char c);
+static void logger_sink_semihosting_end_(const logger_out_t *p_out);
+#endif
+static void logger_sink_begin_(logger_out_t *p_out);
+static void logger_sink_end_(const logger_out_t *p_out);
+
+#if 1 == LOGGER_CONFIG_ENABLE
+static void logger_out_char_(logger_out_t *p_out, char c);
+#if 0 == LOGGER_CONFIG_TOKENIZED
+static void logger_out_str_(logger_out_t *p_out, const char *p_str);
+static void logger_out_hex32_(logger_out_t *p_out, uint32_t value);
+static void logger_out_format_(logger_out_t *p_out, const char *fmt, uint32_t argc, const uintptr_t *p_arg);
+#endif
+static void logger_record_out_(const logger_record_t *p_record, logger_out_t *p_out);
+#endif
+
+#if (1 == LOGGER_CONFIG_ENABLE) && (1 == LOGGER_CONFIG_DEFERRED)
+static bool logger_ring_reserve_(uint32_t *p_head, uint64_t *p_stamp);
+static void logger_atomic_inc_(volatile uint32_t *p_cnt);
+#endif
+
 /********************** internal data definition *****************************/
 
-/********************** external data definition *****************************/
+/* Sinks not compiled in behave as the null sink */
+static const logger_sink_cfg_t logger_sink_cfg_list_[LOGGER_SINK_QTY] = {
+	[LOGGER_SINK_NULL]			= {logger_sink_null_begin_, logger_sink_null_put_, logger_sink_null_end_},
+#if 1 == LOGGER_CONFIG_USE_UART
+	[LOGGER_SINK_UART]			= {logger_sink_uart_begin_, logger_sink_uart_put_, logger_sink_uart_end_},
+	[LOGGER_SINK_UART_POLL]		= {logger_sink_null_begin_, logger_sink_uart_poll_put_, logger_sink_null_end_},
+#else
+	[LOGGER_SINK_UART]			= {logger_sink_null_begin_, logger_sink_null_put_, logger_sink_null_end_},
+	[LOGGER_SINK_UART_POLL]		= {logger_sink_null_begin_, logger_sink_null_put_, logger_sink_null_end_},
+#endif
+#if 1 == LOGGER_CONFIG_USE_SEMIHOSTING
+	[LOGGER_SINK_SEMIHOSTING]	= {logger_sink_semihosting_begin_, logger_sink_semihosting_put_, logger_sink_semihosting_end_},
+#else
+	[LOGGER_SINK_SEMIHOSTING]	= {logger_sink_null_begin_, logger_sink_null_put_, logger_sink_null_end_},
+#endif
+};
 
-#if 1 == LOGGER_CONFIG_ENABLE
-static char logger_msg_buffer_[LOGGER_CONFIG_MAXLEN];
-char* const logger_msg = logger_msg_buffer_;
-int logger_msg_len;
+/* Until logger_sink_select(): nothing leaves the target */
+static volatile logger_sink_t logger_sink_ = LOGGER_SINK_NULL;
+
+#if (1 == LOGGER_CONFIG_ENABLE) && (1 == LOGGER_CONFIG_DEFERRED)
+static logger_ring_t logger_ring_;
 #endif
 
+#if (1 == LOGGER_CONFIG_ENABLE) && (1 == LOGGER_CONFIG_TOKENIZED)
+static uint64_t logger_stamp_last_;		/* delta base, drain side only */
+static uint32_t logger_stamp_cnt_;		/* frames until the next absolute stamp */
+#endif
+
+/********************** external data definition *****************************/
+
+logger_stats_t logger_stats;
+
+volatile uint8_t logger_module_mask[LOGGER_MODULE_QTY] = {
+	[0 ... (LOGGER_MODULE_QTY - 1)] = LOGGER_LEVEL_MASK(LOGGER_CONFIG_RUNTIME_LEVEL)
+};
+
+const char * const logger_level_tag[LOGGER_LEVEL_QTY] = {
+	"[error] ",
+	"[warn] ",
+	"[info] ",
+	"[debug] ",
+	"[trace] "
+};
+
 /********************** internal functions definition ************************/
 
-/********************** external functions definition ************************/
+/* Sinks: reserve the free space, write bytes at offsets, commit the whole line,
+ * leave the reservation for a retry when it did not fit, drop it when it never can */
+static void logger_sink_null_begin_(logger_out_t *p_out)
+{
+	p_out->room = UINT32_MAX;
+	p_out->capacity = UINT32_MAX;
+}
+
+static void logger_sink_null_put_(uint32_t offset, char c)
+{
+    return;
+}
+
+static void logger_sink_null_end_(const logger_out_t *p_out)
+{
+    return;
+}
+
+#if 1 == LOGGER_CONFIG_USE_UART
+static void logger_sink_uart_begin_(logger_out_t *p_out)
+{
+	p_out->room = uart_dma_tx_reserve();
+	p_out->capacity = UART_DMA_TX_RING_SIZE;
+}
+
+static void logger_sink_uart_put_(uint32_t offset, char c)
+{
+	uart_dma_tx_put(offset, c);
+}
+
+static void logger_sink_uart_end_(const logger_out_t *p_out)
+{
+	if (p_out->len <= p_out->room)
+	{
+		uart_dma_tx_commit(p_out->len);
+	}
+	else if (p_out->len > p_out->capacity)
+	{
+		uart_dma_tx_abort(p_out->len);
+	}
+}
+
+/* Blocking: each byte waits for TXE (87 uS per byte at 115200) */
+static void logger_sink_uart_poll_put_(uint32_t offset, char c)
+{
+	uart_dma_tx_poll_put(c);
+}
+#endif
 
 #if 1 == LOGGER_CONFIG_USE_SEMIHOSTING
-void logger_log_print_(char* const msg)
+static void logger_sink_semihosting_begin_(logger_out_t *p_out)
+{
+	p_out->room = UINT32_MAX;
+	p_out->capacity = UINT32_MAX;
+}
+
+static void logger_sink_semihosting_put_(uint32_t offset, char c)
+{
+	putchar(c);
+}
+
+static void logger_sink_semihosting_end_(const logger_out_t *p_out)
 {
-	printf(msg);
 	fflush(stdout);
 }
+#endif
+
+/* Every line starts on the current sink, the debugger is checked again before a
+ * semihosting line (a BKPT without a debugger hard-faults or hangs) */
+static void logger_sink_begin_(logger_out_t *p_out)
+{
+	if ((LOGGER_SINK_SEMIHOSTING == logger_sink_) && (false == logger_debugger_attached()))
+	{
+		logger_sink_select();
+	}
+
+	p_out->p_sink = &logger_sink_cfg_list_[logger_sink_];
+	p_out->len = 0;
+	p_out->p_sink->begin(p_out);
+}
+
+static void logger_sink_end_(const logger_out_t *p_out)
+{
+	p_out->p_sink->end(p_out);
+}
+
+#if 1 == LOGGER_CONFIG_ENABLE
+static void logger_out_char_(logger_out_t *p_out, char c)
+{
+	if (p_out->len < p_out->room)
+	{
+		p_out->p_sink->put(p_out->len, c);
+	}
+	p_out->len++;
+}
+
+#if 0 == LOGGER_CONFIG_TOKENIZED
+static void logger_out_str_(logger_out_t *p_out, const char *p_str)
+{
+	while ('\0' != *p_str)
+	{
+		logger_out_char_(p_out, *p_str++);
+	}
+}
+
+static void logger_out_hex32_(logger_out_t *p_out, uint32_t value)
+{
+	uint32_t shift;
+
+	for (shift = 32; 0 < shift; shift -= 4)
+	{
+		logger_out_char_(p_out, "0123456789abcdef"[(value >> (shift - 4)) & 0xF]);
+	}
+}
+
+/* printf subset on raw 32-bit arguments, straight into the transport */
+static void logger_out_format_(logger_out_t *p_out, const char *fmt, uint32_t argc, const uintptr_t *p_arg)
+{
+	char digits[LOGGER_DIGITS_MAX_];
+	const char *p_str;
+	uint32_t arg_index = 0;
+	uintptr_t arg;
+	uint32_t value;
+	uint32_t width;
+	uint32_t base;
+	uint32_t len;
+	uint32_t index;
+	bool left;
+	bool negative;
+	char pad;
+	char conv;
+
+	while ('\0' != *fmt)
+	{
+		if ('%' != *fmt)
+		{
+			logger_out_char_(p_out, *fmt++);
+			continue;
+		}
+		fmt++;
+
+		/* Flags, width & (ignored) length modifiers */
+		left = false;
+		pad = ' ';
+		for (; ('-' == *fmt) || ('0' == *fmt); fmt++)
+		{
+			if ('-' == *fmt)
+			{
+				left = true;
+			}
+			else
+			{
+				pad = '0';
+			}
+		}
+		for (width = 0; ('0' <= *fmt) && ('9' >= *fmt); fmt++)
+		{
+			width = (width * 10) + (uint32_t)(*fmt - '0');
+		}
+		while (('l' == *fmt) || ('h' == *fmt) || ('z' == *fmt))
+		{
+			fmt++;
+		}
+
+		conv = *fmt;
+		if ('\0' == conv)
+		{
+			break;
+		}
+		fmt++;
+
+		if ('%' == conv)
+		{
+			logger_out_char_(p_out, '%');
+			continue;
+		}
+
+		arg = (argc > arg_index) ? p_arg[arg_index] : 0;
+		arg_index++;
+		value = (uint32_t)arg;
+
+		switch (conv)
+		{
+			case 's':
+
+				p_str = (NULL != (const char *)arg) ? (const char *)arg : "(null)";
+				len = (uint32_t)strlen(p_str);
+				break;
+
+			case 'c':
+
+				digits[0] = (char)value;
+				p_str = digits;
+				len = 1;
+				break;
+
+			case 'd':
+			case 'i':
+			case 'u':
+			case 'x':
+			case 'X':
+			case 'p':
+
+				base = (('x' == conv) || ('X' == conv) || ('p' == conv)) ? 16 : 10;
+				p_str = ('X' == conv) ? "0123456789ABCDEF" : "0123456789abcdef";
+				negative = ((('d' == conv) || ('i' == conv)) && (0 != (value & 0x80000000ul)));
+				if (true == negative)
+				{
+					value = (uint32_t)(-(int32_t)value);
+				}
+
+				/* Digits backwards from the end of the buffer */
+				len = 0;
+				do
+				{
+					digits[LOGGER_DIGITS_MAX_ - 1 - len] = p_str[value % base];
+					value /= base;
+					len++;
+				} while (0 != value);
+
+				/* Sign before the zero padding, or part of the digits */
+				if (true == negative)
+				{
+					if ('0' == pad)
+					{
+						logger_out_char_(p_out, '-');
+						width = (0 < width) ? (width - 1) : 0;
+					}
+					else
+					{
+						digits[LOGGER_DIGITS_MAX_ - 1 - len] = '-';
+						len++;
+					}
+				}
+				p_str = &digits[LOGGER_DIGITS_MAX_ - len];
+				break;
+
+			default:
+
+				/* Unknown conversion: echoed */
+				logger_out_char_(p_out, '%');
+				logger_out_char_(p_out, conv);
+				continue;
+		}
+
+		if (false == left)
+		{
+			for (; width > len; width--)
+			{
+				logger_out_char_(p_out, pad);
+			}
+		}
+		for (index = 0; len > index; index++)
+		{
+			logger_out_char_(p_out, p_str[index]);
+		}
+		for (; width > len; width--)
+		{
+			logger_out_char_(p_out, ' ');
+		}
+	}
+}
+#endif
+
+#if 1 == LOGGER_CONFIG_TOKENIZED
+/* Binary frame, no formatting on target */
+static void logger_record_out_(const logger_record_t *p_record, logger_out_t *p_out)
+{
+	uint32_t id = (uint32_t)(uintptr_t)p_record->fmt;
+	uint64_t delta = p_record->stamp - logger_stamp_last_;
+	uint32_t stamp_len;
+	uint32_t arg;
+	uint32_t index;
+	uint8_t full = 0;
+
+	/* Absolute stamp periodically (decoder sync) or when the delta does not fit */
+	if ((0 == logger_stamp_cnt_) || (0 != (delta >> 32)))
+	{
+		full = LOGGER_TOKEN_FULL;
+		delta = p_record->stamp;
+		logger_stamp_cnt_ = LOGGER_CONFIG_STAMP_FULL_QTY;
+	}
+	logger_stamp_cnt_--;
+	logger_stamp_last_ = p_record->stamp;
+	stamp_len = (0 != full) ? 8 : 4;
+
+	logger_out_char_(p_out, (char)LOGGER_TOKEN_SYNC);
+	logger_out_char_(p_out, (char)(full | (p_record->level << 4) | p_record->argc));
+	logger_out_char_(p_out, (char)id);
+	logger_out_char_(p_out, (char)(id >> 8));
+
+	for (index = 0; stamp_len > index; index++)
+	{
+		logger_out_char_(p_out, (char)(delta >> (8 * index)));
+	}
+
+	for (index = 0; p_record->argc > index; index++)
+	{
+		arg = (uint32_t)p_record->arg[index];
+		logger_out_char_(p_out, (char)arg);
+		logger_out_char_(p_out, (char)(arg >> 8));
+		logger_out_char_(p_out, (char)(arg >> 16));
+		logger_out_char_(p_out, (char)(arg >> 24));
+	}
+}
 #else
+/* "stamp [level] text\n", 64-bit stamp in hex */
+static void logger_record_out_(const logger_record_t *p_record, logger_out_t *p_out)
+{
+	logger_out_hex32_(p_out, (uint32_t)(p_record->stamp >> 32));
+	logger_out_hex32_(p_out, (uint32_t)p_record->stamp);
+	logger_out_char_(p_out, ' ');
+	logger_out_str_(p_out, logger_level_tag[p_record->level]);
+	logger_out_format_(p_out, p_record->fmt, p_record->argc, p_record->arg);
+	logger_out_char_(p_out, '\n');
+}
+#endif
+#endif
+
+#if (1 == LOGGER_CONFIG_ENABLE) && (1 == LOGGER_CONFIG_DEFERRED)
+/* Claim one record, fails (no wait) when the ring is full. The stamp is read
+ * inside the exclusive access: an interrupt in between clears the monitor and
+ * retries, so a later slot never holds an earlier stamp */
+static bool logger_ring_reserve_(uint32_t *p_head, uint64_t *p_stamp)
+{
+	uint32_t head;
+	uint64_t stamp;
+
+	do
+	{
+		head = LOGGER_LDREX_(&logger_ring_.head);
+		if (LOGGER_CONFIG_RING_QTY <= (head - logger_ring_.tail))
+		{
+			LOGGER_CLREX_();
+			return false;
+		}
+		stamp = cycle_counter_get64();
+	} while (0 != LOGGER_STREX_(head, head + 1, &logger_ring_.head));
+
+	*p_head = head;
+	*p_stamp = stamp;
+	return true;
+}
+
+static void logger_atomic_inc_(volatile uint32_t *p_cnt)
+{
+	uint32_t cnt;
+
+	do
+	{
+		cnt = LOGGER_LDREX_(p_cnt);
+	} while (0 != LOGGER_STREX_(cnt, cnt + 1, p_cnt));
+}
+#endif
+
+/********************** external functions definition ************************/
+
+void logger_log_write_(const char *msg, uint32_t len)
+{
+	logger_out_t out;
+	uint32_t index;
+
+	logger_sink_begin_(&out);
+	for (index = 0; len > index; index++)
+	{
+		if (out.len < out.room)
+		{
+			out.p_sink->put(out.len, msg[index]);
+		}
+		out.len++;
+	}
+	logger_sink_end_(&out);
+}
+
 void logger_log_print_(char* const msg)
 {
-    return;
+	logger_log_write_(msg, strlen(msg));
+}
+
+bool logger_debugger_attached(void)
+{
+	return (0 != (CoreDebug->DHCSR & CoreDebug_DHCSR_C_DEBUGEN_Msk));
+}
+
+logger_sink_t logger_sink_select(void)
+{
+	logger_sink_t sink = LOGGER_SINK_NULL;
+
+#if 1 == LOGGER_CONFIG_USE_UART
+	sink = LOGGER_SINK_UART;
+#endif
+#if 1 == LOGGER_CONFIG_USE_SEMIHOSTING
+	if (true == logger_debugger_attached())
+	{
+		sink = LOGGER_SINK_SEMIHOSTING;
+	}
+#endif
+
+	logger_sink_set(sink);
+	return logger_sink_;
+}
+
+void logger_sink_set(logger_sink_t sink)
+{
+	if ((((LOGGER_SINK_UART == sink) || (LOGGER_SINK_UART_POLL == sink)) && (0 == LOGGER_CONFIG_USE_UART)) ||
+		((LOGGER_SINK_SEMIHOSTING == sink) && (0 == LOGGER_CONFIG_USE_SEMIHOSTING)) ||
+		(LOGGER_SINK_QTY <= sink))
+	{
+		sink = LOGGER_SINK_NULL;
+	}
+	logger_sink_ = sink;
+}
+
+logger_sink_t logger_sink_get(void)
+{
+	return logger_sink_;
+}
+
+void logger_module_mask_set(logger_module_t module, uint8_t mask)
+{
+	if (LOGGER_MODULE_QTY > module)
+	{
+		logger_module_mask[module] = mask;
+	}
+}
+
+uint8_t logger_module_mask_get(logger_module_t module)
+{
+	return (LOGGER_MODULE_QTY > module) ? logger_module_mask[module] : 0;
+}
+
+void logger_module_level_set(logger_module_t module, uint32_t level)
+{
+	if (LOGGER_LEVEL_QTY <= level)
+	{
+		level = LOGGER_LEVEL_QTY - 1;
+	}
+	logger_module_mask_set(module, (uint8_t)LOGGER_LEVEL_MASK(level));
+}
+
+void logger_log_sync_(uint32_t level, const char *fmt, uint32_t argc, const uintptr_t *p_arg)
+{
+#if (1 == LOGGER_CONFIG_ENABLE) && (0 == LOGGER_CONFIG_DEFERRED)
+	logger_record_t record;
+	logger_out_t out;
+	uint32_t index;
+
+	record.fmt = fmt;
+	record.level = (uint8_t)level;
+	record.argc = (uint8_t)argc;
+	for (index = 0; LOGGER_CONFIG_ARGS_MAX > index; index++)
+	{
+		record.arg[index] = p_arg[index];
+	}
+
+	__asm("CPSID i");	/* disable interrupts*/
+	record.stamp = cycle_counter_get64();
+	logger_sink_begin_(&out);
+	logger_record_out_(&record, &out);
+	logger_sink_end_(&out);
+
+	/* No retry with interrupts disabled: a line that did not fit is lost */
+	if (out.len > out.room)
+	{
+		logger_stats.dropped++;
+	}
+	else
+	{
+		logger_stats.drain_bytes += out.len;
+	}
+	__asm("CPSIE i");	/* enable interrupts*/
+#endif
 }
+
+void logger_log_deferred_(uint32_t level, const char *fmt, uint32_t argc, const uintptr_t *p_arg)
+{
+#if (1 == LOGGER_CONFIG_ENABLE) && (1 == LOGGER_CONFIG_DEFERRED)
+#if 1 == LOGGER_CONFIG_STATS
+	uint32_t cycles = cycle_counter_get();
+#endif
+	logger_record_t *p_record;
+	uint32_t head;
+	uint64_t stamp;
+	uint32_t index;
+
+	if (false == logger_ring_reserve_(&head, &stamp))
+	{
+		logger_atomic_inc_(&logger_stats.dropped);
+		return;
+	}
+
+	p_record = &logger_ring_.record[head & LOGGER_RING_MASK_];
+	p_record->stamp = stamp;
+	p_record->fmt = fmt;
+	p_record->level = (uint8_t)level;
+	p_record->argc = (uint8_t)argc;
+	for (index = 0; LOGGER_CONFIG_ARGS_MAX > index; index++)
+	{
+		p_record->arg[index] = p_arg[index];
+	}
+
+	/* Record complete before the consumer can see it */
+	LOGGER_DMB_();
+	p_record->ready = 1;
+
+	logger_atomic_inc_(&logger_stats.put);
+
+#if 1 == LOGGER_CONFIG_STATS
+	cycles = cycle_counter_get() - cycles;
+	logger_stats.put_cycles_last = cycles;
+	if (logger_stats.put_cycles_max < cycles)
+	{
+		logger_stats.put_cycles_max = cycles;
+	}
 #endif
+#endif
+}
+
+uint32_t logger_drain(uint32_t qty)
+{
+	uint32_t drained = 0;
+#if (1 == LOGGER_CONFIG_ENABLE) && (1 == LOGGER_CONFIG_DEFERRED)
+	logger_record_t *p_record;
+	logger_out_t out;
+#if 1 == LOGGER_CONFIG_TOKENIZED
+	uint64_t stamp_last;
+	uint32_t stamp_cnt;
+#endif
+#if 1 == LOGGER_CONFIG_STATS
+	uint32_t cycles;
+#endif
+
+	while (drained < qty)
+	{
+		p_record = &logger_ring_.record[logger_ring_.tail & LOGGER_RING_MASK_];
+
+		/* Empty, or reserved but not written yet */
+		if (0 == p_record->ready)
+		{
+			break;
+		}
+
+#if 1 == LOGGER_CONFIG_STATS
+		cycles = cycle_counter_get();
+#endif
+#if 1 == LOGGER_CONFIG_TOKENIZED
+		stamp_last = logger_stamp_last_;
+		stamp_cnt = logger_stamp_cnt_;
+#endif
+		/* Format straight into the transport, whole line or nothing */
+		logger_sink_begin_(&out);
+		logger_record_out_(p_record, &out);
+		logger_sink_end_(&out);
+
+		if (out.len > out.room)
+		{
+			/* Transport full: keep the record, retry on the next idle pass */
+			if (out.len <= out.capacity)
+			{
+#if 1 == LOGGER_CONFIG_TOKENIZED
+				/* The frame was not sent: the decoder still has the previous stamp */
+				logger_stamp_last_ = stamp_last;
+				logger_stamp_cnt_ = stamp_cnt;
+#endif
+				break;
+			}
+
+			/* Larger than the transport itself: it would never fit */
+			logger_atomic_inc_(&logger_stats.dropped);
+		}
+
+		/* Release the record: producers never wait for the output */
+		p_record->ready = 0;
+		LOGGER_DMB_();
+		logger_ring_.tail++;
+		drained++;
+
+#if 1 == LOGGER_CONFIG_STATS
+		cycles = cycle_counter_get() - cycles;
+		logger_stats.drain_cycles_last = cycles;
+		if (logger_stats.drain_cycles_max < cycles)
+		{
+			logger_stats.drain_cycles_max = cycles;
+		}
+#endif
+		/* Every sink, dropped lines excluded */
+		if (out.len <= out.room)
+		{
+			logger_stats.drain_bytes += out.len;
+		}
+	}
+
+	logger_stats.drained += drained;
+#endif
+	return drained;
+}
+
+uint32_t logger_free(void)
+{
+#if (1 == LOGGER_CONFIG_ENABLE) && (1 == LOGGER_CONFIG_DEFERRED)
+	return LOGGER_CONFIG_RING_QTY - (logger_ring_.head - logger_ring_.tail);
+#else
+	return LOGGER_CONFIG_RING_QTY;
+#endif
+}
 
 /********************** end of file ******************************************/
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : profiler.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+/********************** inclusions *******************************************/
+/* Project includes */
+#include "main.h"
+
+/* Demo includes */
+#include "logger.h"
+#include "dwt.h"
+#include "profiler.h"
+
+/********************** macros and definitions *******************************/
+#define PROFILER_CALIBRATE_QTY		(16ul)
+
+/********************** internal data declaration ****************************/
+
+/********************** internal functions declaration ***********************/
+static uint32_t profiler_net_(uint32_t cycles);
+
+/********************** internal data definition *****************************/
+static const char * const profiler_probe_name_[PROFILER_PROBE_QTY] =
+{
+	[PROFILER_PROBE_APP_TICK]		= "app_tick",
+	[PROFILER_PROBE_TASK_SENSOR]	= "task_sensor",
+	[PROFILER_PROBE_TASK_SYSTEM]	= "task_system",
+	[PROFILER_PROBE_TASK_ACTUATOR]	= "task_actuator",
+	[PROFILER_PROBE_LOGGER_DRAIN]	= "logger_drain",
+};
+
+static profiler_dta_t profiler_calibrate_dta_;
+
+/********************** external data declaration ****************************/
+profiler_dta_t profiler_dta_list[PROFILER_PROBE_QTY];
+
+uint32_t profiler_bias_cycles;
+uint32_t profiler_overhead_cycles;
+
+/********************** internal functions definition ************************/
+/* Sample less the empty pair bias, saturated at 0 */
+static uint32_t profiler_net_(uint32_t cycles)
+{
+	return (cycles > profiler_bias_cycles) ? (cycles - profiler_bias_cycles) : 0ul;
+}
+
+/********************** external functions definition ************************/
+void profiler_init(void)
+{
+	uint32_t index;
+	uint32_t cycles;
+	uint32_t start;
+
+	profiler_reset();
+
+	/* Best case of an empty pair: what it reports (the back to back CYCCNT
+	 * reads) & what it costs (both reads & the aggregation) */
+	memset(&profiler_calibrate_dta_, 0, sizeof(profiler_calibrate_dta_));
+	profiler_calibrate_dta_.min = UINT32_MAX;
+	profiler_overhead_cycles = UINT32_MAX;
+	for (index = 0; PROFILER_CALIBRATE_QTY > index; index++)
+	{
+		cycles = cycle_counter_get();
+		start = cycle_counter_get();
+		profiler_dta_add(&profiler_calibrate_dta_, cycle_counter_get() - start);
+		cycles = cycle_counter_get() - cycles;
+
+		if (profiler_overhead_cycles > cycles)
+		{
+			profiler_overhead_cycles = cycles;
+		}
+	}
+	profiler_bias_cycles = profiler_calibrate_dta_.min;
+}
+
+void profiler_reset(void)
+{
+	uint32_t index;
+
+	memset(profiler_dta_list, 0, sizeof(profiler_dta_list));
+	for (index = 0; PROFILER_PROBE_QTY > index; index++)
+	{
+		profiler_dta_list[index].min = UINT32_MAX;
+	}
+}
+
+void profiler_dump(void)
+{
+	const profiler_dta_t *p_dta;
+	uint32_t index;
+	uint32_t bin;
+	uint32_t count;
+
+	if (PROFILER_BUDGET_CYCLES < profiler_overhead_cycles)
+	{
+		LOGGER_WARN("profiler: %lu probes, %lu cycles per probe pair over the %lu budget, bias %lu",
+					(uint32_t)PROFILER_PROBE_QTY, profiler_overhead_cycles, PROFILER_BUDGET_CYCLES,
+					profiler_bias_cycles);
+	}
+	else
+	{
+		LOGGER_INFO("profiler: %lu probes, %lu cycles per probe pair (budget %lu), bias %lu",
+					(uint32_t)PROFILER_PROBE_QTY, profiler_overhead_cycles, PROFILER_BUDGET_CYCLES,
+					profiler_bias_cycles);
+	}
+
+	for (index = 0; PROFILER_PROBE_QTY > index; index++)
+	{
+		p_dta = &profiler_dta_list[index];
+
+		count = 0;
+		for (bin = 0; PROFILER_HIST_QTY > bin; bin++)
+		{
+			count += p_dta->hist[bin];
+		}
+		if (0 == count)
+		{
+			continue;
+		}
+
+		/* Net of the bias, the histogram keeps the raw samples */
+		LOGGER_INFO(" %s n %lu min %lu max %lu avg %lu", profiler_probe_name_[index], count,
+					profiler_net_(p_dta->min), profiler_net_(p_dta->max),
+					profiler_net_((uint32_t)(p_dta->sum / count)));
+		LOGGER_INFO("  <16^n %lu %lu %lu %lu %lu %lu %lu %lu", p_dta->hist[0], p_dta->hist[1],
+					p_dta->hist[2], p_dta->hist[3], p_dta->hist[4], p_dta->hist[5],
+					p_dta->hist[6], p_dta->hist[7]);
+	}
+}
+
+/********************** end of file ******************************************/
@@ -0,0 +1,520 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : shell.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+/********************** inclusions *******************************************/
+/* Project includes */
+#include "main.h"
+
+/* Demo includes */
+#include "logger.h"
+#include "dwt.h"
+#include "profiler.h"
+#include "cpu_load.h"
+#include "stack_monitor.h"
+#include "latency.h"
+#include "e2e_latency.h"
+#include "timer_service.h"
+#include "trace.h"
+#include "uart_dma_tx.h"
+#include "uart_dma_rx.h"
+#include "shell.h"
+
+/* Application & Tasks includes */
+#include "app.h"
+#include "task_system_attribute.h"
+#include "task_system_interface.h"
+#include "task_system.h"
+#include "task_sensor.h"
+#include "task_actuator.h"
+
+/********************** macros and definitions *******************************/
+#if LOGGER_CONFIG_RING_QTY < SHELL_CONFIG_LOG_QTY
+#error "SHELL_CONFIG_LOG_QTY exceeds LOGGER_CONFIG_RING_QTY"
+#endif
+
+/********************** internal data declaration ****************************/
+typedef struct
+{
+	const char	*p_name;
+	const char	*p_help;
+	uint32_t	argc;		/* arguments required, command included */
+	bool		(*p_handler)(uint32_t argc, char *argv[]);	/* false => usage */
+} shell_cmd_t;
+
+typedef struct
+{
+	char		line[SHELL_CONFIG_LINE_MAX];
+	uint32_t	len;
+	bool		overflow;
+	bool		ready;		/* complete line, waiting for room in the logger */
+} shell_dta_t;
+
+/********************** internal functions declaration ***********************/
+static void shell_receive_(char data);
+static void shell_execute_(char *p_line);
+static bool shell_number_(const char *p_text, uint32_t *p_value);
+
+static bool shell_cmd_help_(uint32_t argc, char *argv[]);
+static bool shell_cmd_stats_(uint32_t argc, char *argv[]);
+static bool shell_cmd_prof_(uint32_t argc, char *argv[]);
+static bool shell_cmd_lat_(uint32_t argc, char *argv[]);
+static bool shell_cmd_e2e_(uint32_t argc, char *argv[]);
+static bool shell_cmd_stack_(uint32_t argc, char *argv[]);
+static bool shell_cmd_queues_(uint32_t argc, char *argv[]);
+static bool shell_cmd_system_(uint32_t argc, char *argv[]);
+static bool shell_cmd_sensors_(uint32_t argc, char *argv[]);
+static bool shell_cmd_actuators_(uint32_t argc, char *argv[]);
+static bool shell_cmd_timers_(uint32_t argc, char *argv[]);
+static bool shell_cmd_reset_(uint32_t argc, char *argv[]);
+static bool shell_cmd_tick_(uint32_t argc, char *argv[]);
+static bool shell_cmd_blink_(uint32_t argc, char *argv[]);
+static bool shell_cmd_pulse_(uint32_t argc, char *argv[]);
+static bool shell_cmd_log_(uint32_t argc, char *argv[]);
+static bool shell_cmd_sink_(uint32_t argc, char *argv[]);
+static bool shell_cmd_trace_(uint32_t argc, char *argv[]);
+
+/********************** internal data definition *****************************/
+static const shell_cmd_t shell_cmd_list_[] =
+{
+	{"help",		"",						1, shell_cmd_help_},
+	{"stats",		"(tasks & CPU load)",	1, shell_cmd_stats_},
+	{"prof",		"(profiler probes)",	1, shell_cmd_prof_},
+	{"lat",			"(interrupt latency)",	1, shell_cmd_lat_},
+	{"e2e",			"(stimulus => GPIO)",	1, shell_cmd_e2e_},
+	{"stack",		"(stack & heap)",		1, shell_cmd_stack_},
+	{"queues",		"(depths & drops)",		1, shell_cmd_queues_},
+	{"system",		"(system FSM)",			1, shell_cmd_system_},
+	{"sensors",		"[first]",				1, shell_cmd_sensors_},
+	{"actuators",	"[first]",				1, shell_cmd_actuators_},
+	{"timers",		"(timer service)",		1, shell_cmd_timers_},
+	{"reset",		"(counters)",			1, shell_cmd_reset_},
+	{"tick",		"<sensor> <ticks>",		3, shell_cmd_tick_},
+	{"blink",		"<actuator> <ticks>",	3, shell_cmd_blink_},
+	{"pulse",		"<actuator> <ticks>",	3, shell_cmd_pulse_},
+	{"log",			"<module> <level>",		3, shell_cmd_log_},
+	{"sink",		"<sink>",				2, shell_cmd_sink_},
+	{"trace",		"(freeze & dump)",		1, shell_cmd_trace_},
+};
+
+#define SHELL_CMD_QTY	(sizeof(shell_cmd_list_)/sizeof(shell_cmd_t))
+
+static shell_dta_t shell_dta_;
+
+/********************** external data declaration ****************************/
+shell_stats_t shell_stats;
+
+/********************** internal functions definition ************************/
+/* Line editing: printable characters, backspace, CR or LF ends the line */
+static void shell_receive_(char data)
+{
+	if (('\r' == data) || ('\n' == data))
+	{
+		if (true == shell_dta_.overflow)
+		{
+			shell_stats.rejected++;
+			LOGGER_WARN("shell: line too long");
+		}
+		else if (0 < shell_dta_.len)
+		{
+			shell_dta_.line[shell_dta_.len] = '\0';
+			shell_dta_.ready = true;
+			return;
+		}
+		shell_dta_.len = 0;
+		shell_dta_.overflow = false;
+		return;
+	}
+
+	if (('\b' == data) || (0x7F == data))
+	{
+		if (0 < shell_dta_.len)
+		{
+			shell_dta_.len--;
+		}
+		return;
+	}
+
+	if ((' ' > data) || ('~' < data))
+	{
+		return;
+	}
+
+	if ((SHELL_CONFIG_LINE_MAX - 1) > shell_dta_.len)
+	{
+		shell_dta_.line[shell_dta_.len++] = data;
+	}
+	else
+	{
+		shell_dta_.overflow = true;
+	}
+}
+
+/* Split on spaces in place, find the command & run it. Log arguments are only
+ * constants & integers: the line buffer is reused before the logger formats. */
+static void shell_execute_(char *p_line)
+{
+	char *argv[SHELL_CONFIG_ARG_MAX];
+	uint32_t argc = 0;
+	uint32_t index;
+
+	while (('\0' != *p_line) && (SHELL_CONFIG_ARG_MAX > argc))
+	{
+		while (' ' == *p_line)
+		{
+			*p_line++ = '\0';
+		}
+		if ('\0' == *p_line)
+		{
+			break;
+		}
+
+		argv[argc++] = p_line;
+		while (('\0' != *p_line) && (' ' != *p_line))
+		{
+			p_line++;
+		}
+	}
+
+	if (0 == argc)
+	{
+		return;
+	}
+
+	shell_stats.lines++;
+	for (index = 0; SHELL_CMD_QTY > index; index++)
+	{
+		if (0 == strcmp(argv[0], shell_cmd_list_[index].p_name))
+		{
+			if ((shell_cmd_list_[index].argc > argc) ||
+				(false == shell_cmd_list_[index].p_handler(argc, argv)))
+			{
+				shell_stats.errors++;
+				LOGGER_WARN("shell: %s %s", shell_cmd_list_[index].p_name, shell_cmd_list_[index].p_help);
+			}
+			return;
+		}
+	}
+
+	shell_stats.errors++;
+	LOGGER_WARN("shell: unknown command, try help");
+}
+
+/* Decimal, no sign, false on anything else or overflow */
+static bool shell_number_(const char *p_text, uint32_t *p_value)
+{
+	uint32_t value = 0;
+	uint32_t digit;
+
+	if ('\0' == *p_text)
+	{
+		return false;
+	}
+
+	while ('\0' != *p_text)
+	{
+		if (('0' > *p_text) || ('9' < *p_text))
+		{
+			return false;
+		}
+
+		digit = (uint32_t)(*p_text - '0');
+		if (((UINT32_MAX - digit) / 10u) < value)
+		{
+			return false;
+		}
+		value = value * 10u + digit;
+		p_text++;
+	}
+
+	*p_value = value;
+	return true;
+}
+
+static bool shell_cmd_help_(uint32_t argc, char *argv[])
+{
+	uint32_t index;
+
+	LOGGER_INFO("shell: commands");
+	for (index = 0; SHELL_CMD_QTY > index; index++)
+	{
+		LOGGER_INFO(" %s %s", shell_cmd_list_[index].p_name, shell_cmd_list_[index].p_help);
+	}
+	return true;
+}
+
+static bool shell_cmd_stats_(uint32_t argc, char *argv[])
+{
+	cpu_load_t cpu_load;
+
+	app_dump();
+
+	cpu_load_get(&cpu_load);
+	LOGGER_INFO("cpu: second load %lu isr %lu idle %lu, minute load %lu, max %lu, per mille",
+				(uint32_t)cpu_load.second.load, (uint32_t)cpu_load.second.isr,
+				(uint32_t)cpu_load.second.idle, (uint32_t)cpu_load.minute.load,
+				(uint32_t)cpu_load.load_max);
+	return true;
+}
+
+static bool shell_cmd_prof_(uint32_t argc, char *argv[])
+{
+	profiler_dump();
+	return true;
+}
+
+static bool shell_cmd_lat_(uint32_t argc, char *argv[])
+{
+	latency_dump();
+	return true;
+}
+
+static bool shell_cmd_e2e_(uint32_t argc, char *argv[])
+{
+	e2e_dump();
+	return true;
+}
+
+static bool shell_cmd_stack_(uint32_t argc, char *argv[])
+{
+	stack_monitor_dump();
+	return true;
+}
+
+static bool shell_cmd_queues_(uint32_t argc, char *argv[])
+{
+	LOGGER_INFO("queues: system %lu max %lu", count_event_task_system(), count_max_event_task_system());
+	LOGGER_INFO(" logger free %lu put %lu dropped %lu", logger_free(), logger_stats.put, logger_stats.dropped);
+	LOGGER_INFO(" uart tx free %lu level_max %lu dropped %lu", uart_dma_tx_free(),
+				uart_dma_tx_stats.level_max, uart_dma_tx_stats.dropped);
+	LOGGER_INFO(" uart rx available %lu bytes %lu overrun %lu", uart_dma_rx_available(),
+				uart_dma_rx_stats.bytes, uart_dma_rx_stats.overrun);
+	LOGGER_INFO(" shell lines %lu errors %lu rejected %lu cycles_max %lu", shell_stats.lines,
+				shell_stats.errors, shell_stats.rejected, shell_stats.cycles_max);
+	return true;
+}
+
+static bool shell_cmd_system_(uint32_t argc, char *argv[])
+{
+	task_system_dump();
+	return true;
+}
+
+static bool shell_cmd_sensors_(uint32_t argc, char *argv[])
+{
+	uint32_t first = 0;
+	uint32_t next;
+
+	if ((2 < argc) || ((2 == argc) && (false == shell_number_(argv[1], &first))))
+	{
+		return false;
+	}
+
+	next = task_sensor_dump(first, SHELL_CONFIG_PAGE_QTY);
+	if ((first + SHELL_CONFIG_PAGE_QTY) == next)
+	{
+		LOGGER_INFO(" more: sensors %lu", next);
+	}
+	return true;
+}
+
+static bool shell_cmd_actuators_(uint32_t argc, char *argv[])
+{
+	uint32_t first = 0;
+	uint32_t next;
+
+	if ((2 < argc) || ((2 == argc) && (false == shell_number_(argv[1], &first))))
+	{
+		return false;
+	}
+
+	next = task_actuator_dump(first, SHELL_CONFIG_PAGE_QTY);
+	if ((first + SHELL_CONFIG_PAGE_QTY) == next)
+	{
+		LOGGER_INFO(" more: actuators %lu", next);
+	}
+	return true;
+}
+
+static bool shell_cmd_timers_(uint32_t argc, char *argv[])
+{
+	LOGGER_INFO("timers: pending %lu max %lu fired %lu late_max %lu uS isr_max %lu cycles",
+				timer_service_pending(), timer_service_stats.pending_max, timer_service_stats.fired,
+				timer_service_stats.late_us_max, timer_service_stats.isr_cycles_max);
+	return true;
+}
+
+static bool shell_cmd_reset_(uint32_t argc, char *argv[])
+{
+	profiler_reset();
+	cpu_load_reset();
+	latency_reset();
+	e2e_reset();
+	app_wcet_reset();
+	clear_count_max_event_task_system();
+	timer_service_stats.pending_max = timer_service_pending();
+	timer_service_stats.late_us_max = 0;
+	timer_service_stats.isr_cycles_max = 0;
+	shell_stats.cycles_max = 0;
+
+	LOGGER_INFO("shell: counters reset");
+	return true;
+}
+
+static bool shell_cmd_tick_(uint32_t argc, char *argv[])
+{
+	uint32_t index;
+	uint32_t tick;
+
+	if ((false == shell_number_(argv[1], &index)) || (false == shell_number_(argv[2], &tick)) ||
+		(false == task_sensor_tick_max_set(index, tick)))
+	{
+		return false;
+	}
+
+	LOGGER_INFO("shell: sensor %lu tick_max %lu", index, tick);
+	return true;
+}
+
+static bool shell_cmd_blink_(uint32_t argc, char *argv[])
+{
+	uint32_t index;
+	uint32_t tick;
+
+	if ((false == shell_number_(argv[1], &index)) || (false == shell_number_(argv[2], &tick)) ||
+		(0 == tick) || (false == task_actuator_tick_set(index, tick, 0)))
+	{
+		return false;
+	}
+
+	LOGGER_INFO("shell: actuator %lu tick_blink %lu", index, tick);
+	return true;
+}
+
+static bool shell_cmd_pulse_(uint32_t argc, char *argv[])
+{
+	uint32_t index;
+	uint32_t tick;
+
+	if ((false == shell_number_(argv[1], &index)) || (false == shell_number_(argv[2], &tick)) ||
+		(0 == tick) || (false == task_actuator_tick_set(index, 0, tick)))
+	{
+		return false;
+	}
+
+	LOGGER_INFO("shell: actuator %lu tick_pulse %lu", index, tick);
+	return true;
+}
+
+static bool shell_cmd_log_(uint32_t argc, char *argv[])
+{
+	uint32_t module;
+	uint32_t level;
+
+	if ((false == shell_number_(argv[1], &module)) || (LOGGER_MODULE_QTY <= module) ||
+		(false == shell_number_(argv[2], &level)) || (LOGGER_LEVEL_QTY <= level))
+	{
+		return false;
+	}
+
+	logger_module_level_set((logger_module_t)module, level);
+	LOGGER_INFO("shell: module %lu level %lu", module, level);
+	return true;
+}
+
+static bool shell_cmd_sink_(uint32_t argc, char *argv[])
+{
+	uint32_t sink;
+
+	if ((false == shell_number_(argv[1], &sink)) || (LOGGER_SINK_QTY <= sink))
+	{
+		return false;
+	}
+
+	logger_sink_set((logger_sink_t)sink);
+	LOGGER_INFO("shell: sink %lu", (uint32_t)logger_sink_get());
+	return true;
+}
+
+static bool shell_cmd_trace_(uint32_t argc, char *argv[])
+{
+	trace_trigger();
+	LOGGER_INFO("shell: trace frozen, dumping");
+	return true;
+}
+
+/********************** external functions definition ************************/
+void shell_init(void)
+{
+	memset(&shell_dta_, 0, sizeof(shell_dta_));
+	memset(&shell_stats, 0, sizeof(shell_stats));
+}
+
+void shell_update(void)
+{
+	uint32_t cycles;
+	uint32_t index;
+	char data;
+
+	/* Bytes until a line is complete, it is kept until it runs */
+	for (index = 0; (SHELL_CONFIG_RX_QTY > index) && (false == shell_dta_.ready); index++)
+	{
+		if (0 == uart_dma_rx_read(&data, 1))
+		{
+			break;
+		}
+		shell_receive_(data);
+	}
+
+	/* One command, with room in the logger ring for all its lines */
+	if ((false == shell_dta_.ready) || (SHELL_CONFIG_LOG_QTY > logger_free()))
+	{
+		return;
+	}
+
+	cycles = cycle_counter_get();
+	shell_execute_(shell_dta_.line);
+	cycles = cycle_counter_get() - cycles;
+	if (shell_stats.cycles_max < cycles)
+	{
+		shell_stats.cycles_max = cycles;
+	}
+
+	shell_dta_.len = 0;
+	shell_dta_.ready = false;
+}
+
+/********************** end of file ******************************************/
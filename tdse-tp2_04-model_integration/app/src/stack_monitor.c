@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : stack_monitor.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+/********************** inclusions *******************************************/
+/* Project includes */
+#include "main.h"
+
+/* Demo includes */
+#include "logger.h"
+#include "stack_monitor.h"
+
+/********************** macros and definitions *******************************/
+
+/********************** internal data declaration ****************************/
+/* Symbols defined in the linker script */
+extern uint32_t _end;
+extern uint32_t _estack;
+extern uint32_t _Min_Stack_Size;
+extern uint32_t _Min_Heap_Size;
+
+/* sysmem.c */
+extern void *_sbrk(ptrdiff_t incr);
+
+/********************** internal functions declaration ***********************/
+static uint32_t *stack_monitor_break_(void);
+static void stack_monitor_check_(void);
+
+/********************** internal data definition *****************************/
+static uint32_t *stack_monitor_low_;		/* lowest stack word seen written */
+static uint32_t *stack_monitor_cursor_;		/* next word of the scan */
+static uint32_t stack_monitor_status_;
+static uint32_t stack_monitor_reported_;
+
+/********************** external data declaration ****************************/
+volatile uint32_t stack_monitor_isr_sp_min;
+
+/********************** internal functions definition ************************/
+static uint32_t *stack_monitor_break_(void)
+{
+	/* First heap word not handed out by _sbrk(), word aligned */
+	return (uint32_t *)(((uint32_t)_sbrk(0) + 3ul) & ~3ul);
+}
+
+static void stack_monitor_check_(void)
+{
+	uint32_t stack_limit = (uint32_t)&_estack - (uint32_t)&_Min_Stack_Size;
+	uint32_t heap_limit = (uint32_t)&_end + (uint32_t)&_Min_Heap_Size;
+	uint32_t low = (uint32_t)stack_monitor_low_;
+	uint32_t brk = (uint32_t)stack_monitor_break_();
+	uint32_t status;
+
+	if (low > stack_monitor_isr_sp_min)
+	{
+		low = stack_monitor_isr_sp_min;
+	}
+
+	status = 0;
+	if (stack_limit > low)
+	{
+		status |= (1ul << STACK_MONITOR_STACK_OVER);
+	}
+	if (heap_limit < brk)
+	{
+		status |= (1ul << STACK_MONITOR_HEAP_OVER);
+	}
+	if ((low < brk) || (STACK_MONITOR_CONFIG_MARGIN > (low - brk)))
+	{
+		status |= (1ul << STACK_MONITOR_MARGIN);
+	}
+	stack_monitor_status_ |= status;
+
+	/* Report each condition once, while there is still room before .bss */
+	status = stack_monitor_status_ & ~stack_monitor_reported_;
+	if (0 != status)
+	{
+		stack_monitor_reported_ |= status;
+		if (0 != (status & (1ul << STACK_MONITOR_MARGIN)))
+		{
+			LOGGER_ERROR("stack_monitor: heap & stack %lu bytes apart", (low > brk) ? (low - brk) : 0ul);
+		}
+		if (0 != (status & ((1ul << STACK_MONITOR_STACK_OVER) | (1ul << STACK_MONITOR_HEAP_OVER))))
+		{
+			stack_monitor_dump();
+		}
+	}
+}
+
+/********************** external functions definition ************************/
+void stack_monitor_init(void)
+{
+	uint32_t sp = __get_MSP();
+
+	/* The frames above the current one are in use, the scan starts below */
+	stack_monitor_low_ = (uint32_t *)sp;
+	stack_monitor_cursor_ = stack_monitor_break_();
+	stack_monitor_isr_sp_min = sp;
+	stack_monitor_status_ = 0;
+	stack_monitor_reported_ = 0;
+}
+
+void stack_monitor_update(void)
+{
+	uint32_t index;
+
+	/* From the heap break up to the lowest word known written: the first word
+	 * that lost the paint is the new high-water, then the scan starts over */
+	for (index = 0; STACK_MONITOR_CONFIG_SCAN_QTY > index; index++)
+	{
+		if (stack_monitor_cursor_ >= stack_monitor_low_)
+		{
+			stack_monitor_cursor_ = stack_monitor_break_();
+			stack_monitor_check_();
+			break;
+		}
+
+		if (STACK_MONITOR_PAINT != *stack_monitor_cursor_)
+		{
+			stack_monitor_low_ = stack_monitor_cursor_;
+			stack_monitor_cursor_ = stack_monitor_break_();
+			stack_monitor_check_();
+			break;
+		}
+
+		stack_monitor_cursor_++;
+	}
+}
+
+void stack_monitor_get(stack_monitor_t *p_stack_monitor)
+{
+	uint32_t estack = (uint32_t)&_estack;
+	uint32_t low = (uint32_t)stack_monitor_low_;
+	uint32_t brk = (uint32_t)stack_monitor_break_();
+
+	p_stack_monitor->stack_max = estack - low;
+	p_stack_monitor->stack_isr_max = estack - stack_monitor_isr_sp_min;
+	p_stack_monitor->stack_size = (uint32_t)&_Min_Stack_Size;
+	p_stack_monitor->heap_max = brk - (uint32_t)&_end;
+	p_stack_monitor->heap_size = (uint32_t)&_Min_Heap_Size;
+	p_stack_monitor->free = (low > brk) ? (low - brk) : 0;
+	p_stack_monitor->status = stack_monitor_status_;
+}
+
+void stack_monitor_dump(void)
+{
+	stack_monitor_t stack_monitor;
+
+	stack_monitor_get(&stack_monitor);
+
+	LOGGER_INFO("stack_monitor: stack %lu (isr entry %lu) of %lu, heap %lu of %lu, free %lu, status 0x%lx",
+				stack_monitor.stack_max, stack_monitor.stack_isr_max, stack_monitor.stack_size,
+				stack_monitor.heap_max, stack_monitor.heap_size, stack_monitor.free,
+				stack_monitor.status);
+}
+
+/********************** end of file ******************************************/
@@ -39,56 +39,109 @@
 /* Project includes */
 #include "main.h"
 
+/* Demo includes */
+#include "dwt.h"
+#include "systick.h"
+
 /********************** macros and definitions *******************************/
 
 /********************** internal data declaration ****************************/
 
 /********************** internal functions declaration ***********************/
+static uint64_t systick_now_(uint32_t *p_elapsed);
 
 /********************** internal data definition *****************************/
 
 /********************** external data declaration ****************************/
+volatile uint32_t systick_tick_ext;
+
+/********************** internal functions definition ************************/
+/* Current 64-bit tick & elapsed counts of the down counter as one consistent pair:
+ * - uwTick changed during the reads (SysTick ISR ran) => read again
+ * - uwTick wrapped since the last systick_extend() => high word + 1
+ * - SysTick pending (counter reloaded, ISR not run yet: masked, or a higher
+ *   priority ISR running) => the tick is one ahead of uwTick, the counter is
+ *   read again to be sure it is the reloaded one */
+static uint64_t systick_now_(uint32_t *p_elapsed)
+{
+	uint32_t ext;
+	uint32_t tick;
+	uint32_t hi;
+	uint32_t val;
+	uint32_t pending;
+
+	do
+	{
+		ext = systick_tick_ext;
+		tick = uwTick;
+		val = SysTick->VAL;
+		pending = (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) >> SCB_ICSR_PENDSTSET_Pos;
+		if (0 != pending)
+		{
+			val = SysTick->VAL;
+		}
+	} while (tick != uwTick);
+
+	*p_elapsed = SysTick->LOAD - val;
+
+	hi = ext >> 1;
+	if ((1 == (ext & 1)) && (0 == (tick >> 31)))
+	{
+		hi++;
+	}
+	return ((((uint64_t)hi << 32) | tick) + pending);
+}
 
 /********************** external functions definition ************************/
-/* Provides a blocking delay in microseconds using the SysTick timer */
+void systick_extend(void)
+{
+	uint32_t ext = systick_tick_ext;
+	uint32_t msb = uwTick >> 31;
+
+	/* bit 31 fell from 1 to 0 => uwTick wrapped */
+	if ((1 == (ext & 1)) && (0 == msb))
+	{
+		ext += 2;
+	}
+	systick_tick_ext = (ext & ~1ul) | msb;
+}
+
+/* Provides a blocking delay in microseconds using the SysTick timer (any length,
+ * longer than one tick with interrupts enabled) */
 void systick_delay_us(uint32_t delay_us)
 {
-	uint32_t start, current, target, elapsed;
+	uint64_t start, target;
 
     if (0 == delay_us)
     	return;
 
-    /* Get the start value of the SysTick counter */
-	start = SysTick->VAL;
+    /* Get the start value of the cycle clock */
+	start = now_cycles();
 
 	/* Calculate the total number of SysTick counts required for the delay */
-	target = delay_us * (SystemCoreClock / 1000000UL);
+	target = (uint64_t)delay_us * (SystemCoreClock / 1000000UL);
 
     /* Loop until the required counts have elapsed */
-    while (1)
-    {
-        /* Get the current value of the SysTick counter */
-    	current = SysTick->VAL;
-
-        /* Handle the case where the SysTick counter wraps around, */
-        /* counts down to 0 and reloads */
-        if (current <= start)
-        {
-        	elapsed = start - current;
-        }
-        else
-        {
-            /* Counter wrapped around, */
-        	/* add the reload value to account for the wrap */
-        	elapsed = SysTick->LOAD + start - current;
-        }
-
-        /* Exit the loop when the desired delay is reached */
-        if (elapsed >= target)
-        {
-        	break;
-        }
-    }
+	while ((now_cycles() - start) < target)
+	{
+	}
+}
+
+uint64_t now_cycles(void)
+{
+	uint32_t elapsed;
+	uint64_t tick = systick_now_(&elapsed);
+
+	return (tick * (SysTick->LOAD + 1)) + elapsed;
+}
+
+uint64_t now_us(void)
+{
+	uint32_t elapsed;
+	uint64_t tick = systick_now_(&elapsed);
+
+	/* Part of the tick: multiply & shift (dwt.h constants), no divide */
+	return (tick * 1000u) + cycle_counter_to_us(elapsed);
 }
 
 /********************** end of file ******************************************/
@@ -40,14 +40,24 @@
 #include "main.h"
 
 /* Demo includes */
+#define LOGGER_MODULE			LOGGER_MODULE_TASK_ACTUATOR
 #include "logger.h"
 #include "dwt.h"
+#include "bitmap.h"
+#include "gpio_stage.h"
+#include "trace.h"
+#include "latency.h"
+#include "e2e_latency.h"
+#include "timer_service.h"
 
 /* Application & Tasks includes */
 #include "board.h"
 #include "app.h"
 #include "task_actuator_attribute.h"
 #include "task_actuator_interface.h"
+#include "task_actuator_tim.h"
+#include "task_actuator_pattern.h"
+#include "task_actuator_bam.h"
 
 /********************** macros and definitions *******************************/
 #define G_TASK_ACT_CNT_INIT			0ul
@@ -57,22 +67,65 @@
 #define DEL_LED_XX_BLI				500ul
 #define DEL_LED_XX_MIN				0ul
 
+/* Task tick in uS (HAL_TICK_FREQ_1KHZ), timer_service delays */
+#define TASK_ACT_TICK_US			1000ul
+
 /********************** internal data declaration ****************************/
+#if (1 == TASK_ACTUATOR_CONFIG_BOARD)
+#if (1 == TASK_ACTUATOR_CONFIG_TUNABLE)
+task_actuator_cfg_t task_actuator_cfg_list[] = {
+#else
 const task_actuator_cfg_t task_actuator_cfg_list[] = {
+#endif
 	{ID_LED_A,  LED_A_PORT,  LED_A_PIN, LED_A_ON,  LED_A_OFF,
-	 DEL_LED_XX_BLI, DEL_LED_XX_PUL}
+	 DEL_LED_XX_BLI, DEL_LED_XX_PUL,
+	 LED_A_KIND, LED_A_TIM, LED_A_TIM_CH, LED_XX_BRIGHTNESS_MAX}
 };
+#endif
 
 #define ACTUATOR_CFG_QTY	(sizeof(task_actuator_cfg_list)/sizeof(task_actuator_cfg_t))
 
-task_actuator_dta_t task_actuator_dta_list[] = {
-	{DEL_LED_XX_MIN, ST_LED_XX_OFF, EV_LED_XX_NOT_BLINK, false}
-};
+#if (1 == TASK_ACTUATOR_CONFIG_SOA)
+uint32_t task_actuator_dta_tick[ACTUATOR_CFG_QTY];
+uint8_t task_actuator_dta_state[ACTUATOR_CFG_QTY];
+uint8_t task_actuator_dta_event[ACTUATOR_CFG_QTY];
+uint32_t task_actuator_dta_flag[BITMAP_WORDS(ACTUATOR_CFG_QTY)];
+#else
+task_actuator_dta_t task_actuator_dta_list[ACTUATOR_CFG_QTY];	/* task_actuator_init() */
+#endif
+
+#define ACTUATOR_DTA_QTY	(ACTUATOR_CFG_QTY)
+
+/* Every actuator must be able to play patterns (EV_LED_XX_PATTERN) */
+_Static_assert(ACTUATOR_DTA_QTY <= TASK_ACTUATOR_PATTERN_QTY_MAX, "TASK_ACTUATOR_PATTERN_QTY_MAX below the actuator qty");
+
+/* Any actuator may be KIND_LED_XX_BAM, its slot is its table index */
+_Static_assert(ACTUATOR_DTA_QTY <= TASK_ACTUATOR_BAM_QTY_MAX, "TASK_ACTUATOR_BAM_QTY_MAX below the actuator qty");
+
+#if (1 == TRACE_CONFIG_ENABLE)
+/* Trace records carry the table index in 8 bits (TRACE_STATE(), TRACE_EVENT_GET()) */
+_Static_assert(ACTUATOR_DTA_QTY <= TRACE_INSTANCE_QTY_MAX, "TRACE_INSTANCE_QTY_MAX below the actuator qty");
+#endif
 
-#define ACTUATOR_DTA_QTY	(sizeof(task_actuator_dta_list)/sizeof(task_actuator_dta_t))
+uint32_t task_actuator_dta_active[BITMAP_WORDS(ACTUATOR_DTA_QTY)];
+
+/* PULSE width of GPIO & BAM actuators on a timer_service one-shot, its id or
+ * TIMER_SERVICE_NONE (no timer free: tick counting) */
+uint8_t task_actuator_pulse_timer[ACTUATOR_DTA_QTY];
+
+/* Pulses ended: set by the one-shot (TIM2 interrupt), taken by the statechart */
+volatile uint32_t task_actuator_pulse_end[BITMAP_WORDS(ACTUATOR_DTA_QTY)];
 
 /********************** internal functions declaration ***********************/
 void task_actuator_statechart(void);
+void task_actuator_led_on(const task_actuator_cfg_t *p_task_actuator_cfg);
+void task_actuator_led_off(const task_actuator_cfg_t *p_task_actuator_cfg);
+void task_actuator_led_blink(uint32_t index, const task_actuator_cfg_t *p_task_actuator_cfg);
+void task_actuator_led_pulse(uint32_t index, const task_actuator_cfg_t *p_task_actuator_cfg);
+void task_actuator_led_level(const task_actuator_cfg_t *p_task_actuator_cfg, uint32_t level);
+bool task_actuator_led_pattern(uint32_t index, const task_actuator_cfg_t *p_task_actuator_cfg);
+bool task_actuator_settled(uint32_t index, const task_actuator_cfg_t *p_task_actuator_cfg);
+void task_actuator_pulse_elapsed(void *p_arg);
 
 /********************** internal data definition *****************************/
 const char *p_task_actuator 		= "Task Actuator (Actuator Statechart)";
@@ -81,13 +134,13 @@ const char *p_task_actuator_ 		= "Non-Blocking & Update By Time Code";
 /********************** external data declaration ****************************/
 uint32_t g_task_actuator_cnt;
 volatile uint32_t g_task_actuator_tick_cnt;
+uint32_t g_task_actuator_ev_dropped;
 
 /********************** external functions definition ************************/
 void task_actuator_init(void *parameters)
 {
 	uint32_t index;
 	const task_actuator_cfg_t *p_task_actuator_cfg;
-	task_actuator_dta_t *p_task_actuator_dta;
 	task_actuator_st_t state;
 	task_actuator_ev_t event;
 	bool b_event;
@@ -101,21 +154,34 @@ void task_actuator_init(void *parameters)
 	g_task_actuator_cnt = G_TASK_ACT_CNT_INIT;
 	LOGGER_INFO("   %s = %lu", GET_NAME(g_task_actuator_cnt), g_task_actuator_cnt);
 
+	task_actuator_pattern_init();
+	task_actuator_bam_init();
+
 	for (index = 0; ACTUATOR_DTA_QTY > index; index++)
 	{
-		/* Update Task Actuator Configuration & Data Pointer */
+		/* Update Task Actuator Configuration Pointer */
 		p_task_actuator_cfg = &task_actuator_cfg_list[index];
-		p_task_actuator_dta = &task_actuator_dta_list[index];
+
+		/* put_event_task_actuator() takes the identifier as the table index */
+		if (index != (uint32_t)p_task_actuator_cfg->identifier)
+		{
+			LOGGER_ERROR("   %s: actuator %lu identifier %lu out of table order", GET_NAME(task_actuator_init), index,
+						 (uint32_t)p_task_actuator_cfg->identifier);
+		}
 
 		/* Init & Print out: Index & Task execution FSM */
+		TASK_ACTUATOR_DTA_TICK(index) = DEL_LED_XX_MIN;
+
 		state = ST_LED_XX_OFF;
-		p_task_actuator_dta->state = state;
+		TASK_ACTUATOR_DTA_STATE(index) = state;
 
 		event = EV_LED_XX_OFF;
-		p_task_actuator_dta->event = event;
+		TASK_ACTUATOR_DTA_EVENT(index) = event;
 
 		b_event = false;
-		p_task_actuator_dta->flag = b_event;
+		TASK_ACTUATOR_DTA_FLAG_CLR(index);
+		TASK_ACTUATOR_DTA_ACTIVE_SET(index);
+		task_actuator_pulse_timer[index] = TIMER_SERVICE_NONE;
 
 		LOGGER_INFO(" ");
 		LOGGER_INFO("   %s = %lu   %s = %lu   %s = %lu   %s = %s",
@@ -124,13 +190,24 @@ void task_actuator_init(void *parameters)
 					 GET_NAME(event), (uint32_t)event,
 					 GET_NAME(b_event), (b_event ? "true" : "false"));
 
-		HAL_GPIO_WritePin(p_task_actuator_cfg->gpio_port, p_task_actuator_cfg->pin, p_task_actuator_cfg->led_off);
+		if (KIND_LED_XX_TIM == p_task_actuator_cfg->kind)
+			(void)task_actuator_tim_init(p_task_actuator_cfg);
+		else if (KIND_LED_XX_BAM == p_task_actuator_cfg->kind)
+			task_actuator_bam_attach(index, p_task_actuator_cfg);
+
+		task_actuator_led_off(p_task_actuator_cfg);
 	}
+
+	/* All outputs at the same instant */
+	gpio_stage_commit();
+	task_actuator_bam_update();
+	task_actuator_bam_start();
 }
 
 void task_actuator_update(void *parameters)
 {
 	bool b_time_update_required = false;
+	bool b_output;
 
 	/* Protect shared resource */
 	__asm("CPSID i");	/* disable interrupts*/
@@ -164,66 +241,439 @@ void task_actuator_update(void *parameters)
 		}
 		__asm("CPSIE i");	/* enable interrupts */
     }
+
+    /* Commit the outputs staged in this actuator pass, one BSRR write per port */
+    b_output = (0 != gpio_stage.dirty);
+    gpio_stage_commit();
+    if (true == b_output)
+    {
+    	/* EXTI edge => output change latency */
+    	LATENCY_OUTPUT();
+    }
+    /* Events taken in this pass => GPIO, per hop & per path */
+    E2E_OUTPUT();
+    task_actuator_bam_update();
+}
+
+uint32_t task_actuator_dump(uint32_t first, uint32_t qty)
+{
+	uint32_t index;
+
+	if (0 == first)
+	{
+		LOGGER_INFO("actuator: %lu dropped %lu", (uint32_t)ACTUATOR_DTA_QTY, g_task_actuator_ev_dropped);
+	}
+
+	for (index = first; (ACTUATOR_DTA_QTY > index) && ((first + qty) > index); index++)
+	{
+		LOGGER_INFO(" %lu state %lu tick %lu blink %lu pulse %lu event %lu pending %lu active %lu", index,
+					(uint32_t)TASK_ACTUATOR_DTA_STATE(index),
+					TASK_ACTUATOR_DTA_TICK(index), task_actuator_cfg_list[index].tick_blink,
+					task_actuator_cfg_list[index].tick_pulse, (uint32_t)TASK_ACTUATOR_DTA_EVENT(index),
+					(uint32_t)TASK_ACTUATOR_DTA_FLAG(index), (uint32_t)bitmap_get(task_actuator_dta_active, index));
+	}
+
+	return index;
+}
+
+bool task_actuator_tick_set(uint32_t index, uint32_t tick_blink, uint32_t tick_pulse)
+{
+#if (1 == TASK_ACTUATOR_CONFIG_TUNABLE)
+	if (ACTUATOR_CFG_QTY > index)
+	{
+		/* 0 keeps the current one, a new value applies from the next BLINK / PULSE */
+		if (0 != tick_blink)
+		{
+			task_actuator_cfg_list[index].tick_blink = tick_blink;
+		}
+		if (0 != tick_pulse)
+		{
+			task_actuator_cfg_list[index].tick_pulse = tick_pulse;
+		}
+		return true;
+	}
+#endif
+	return false;
 }
 
 void task_actuator_statechart(void)
 {
 	uint32_t index;
 	const task_actuator_cfg_t *p_task_actuator_cfg;
-	task_actuator_dta_t *p_task_actuator_dta;
+	uint32_t level;
+	bool b_end;
+	uint32_t word;
+	uint32_t pending;
+	uint32_t state;
+	uint32_t event;
+	bool b_event;
 
-	for (index = 0; ACTUATOR_DTA_QTY > index; index++)
+	/* Pattern steps due at this tick, from the shared deadline heap */
+	while (task_actuator_pattern_next(g_task_actuator_cnt, &index, &level, &b_end))
 	{
-		/* Update Task Actuator Configuration & Data Pointer */
+		task_actuator_led_level(&task_actuator_cfg_list[index], level);
+
+		if (true == b_end)
+		{
+			TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_OFF;
+			TRACE_STATE(TRACE_FSM_ACTUATOR, index, ST_LED_XX_PATTERN, ST_LED_XX_OFF);
+		}
+	}
+
+	/* Pulses ended by their one-shot since the last tick */
+	for (word = 0; BITMAP_WORDS(ACTUATOR_DTA_QTY) > word; word++)
+	{
+		if (0 == task_actuator_pulse_end[word])
+			continue;
+
+		/* Protect shared resource */
+		__asm("CPSID i");	/* disable interrupts */
+		pending = task_actuator_pulse_end[word];
+		task_actuator_pulse_end[word] = 0;
+		__asm("CPSIE i");	/* enable interrupts */
+
+		while (0 != pending)
+		{
+			index = (word << 5) + (uint32_t)__builtin_ctz(pending);
+			pending &= pending - 1ul;
+
+			task_actuator_pulse_timer[index] = TIMER_SERVICE_NONE;
+			if (ST_LED_XX_PULSE == TASK_ACTUATOR_DTA_STATE(index))
+			{
+				task_actuator_led_off(&task_actuator_cfg_list[index]);
+				TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_OFF;
+				TRACE_STATE(TRACE_FSM_ACTUATOR, index, ST_LED_XX_PULSE, ST_LED_XX_OFF);
+
+				/* Event received during the pulse */
+				if (true == TASK_ACTUATOR_DTA_FLAG(index))
+					TASK_ACTUATOR_DTA_ACTIVE_SET(index);
+			}
+		}
+	}
+
+	/* Active actuators only, CTZ over the bitmap */
+	for (index = bitmap_next(task_actuator_dta_active, ACTUATOR_DTA_QTY, 0);
+		 ACTUATOR_DTA_QTY > index;
+		 index = bitmap_next(task_actuator_dta_active, ACTUATOR_DTA_QTY, index + 1))
+	{
+		/* Update Task Actuator Configuration Pointer */
 		p_task_actuator_cfg = &task_actuator_cfg_list[index];
-		p_task_actuator_dta = &task_actuator_dta_list[index];
 
-		switch (p_task_actuator_dta->state)
+		/* Trace: event consumed & state transition */
+		state = TASK_ACTUATOR_DTA_STATE(index);
+		event = TASK_ACTUATOR_DTA_EVENT(index);
+		b_event = TASK_ACTUATOR_DTA_FLAG(index);
+
+		switch (TASK_ACTUATOR_DTA_STATE(index))
 		{
 			case ST_LED_XX_OFF:
 
-				if ((true == p_task_actuator_dta->flag) && (EV_LED_XX_ON == p_task_actuator_dta->event))
+				if ((true == TASK_ACTUATOR_DTA_FLAG(index)) && (EV_LED_XX_ON == TASK_ACTUATOR_DTA_EVENT(index)))
+				{
+					TASK_ACTUATOR_DTA_FLAG_CLR(index);
+					task_actuator_led_on(p_task_actuator_cfg);
+					TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_ON;
+				}
+				else if ((true == TASK_ACTUATOR_DTA_FLAG(index)) && (EV_LED_XX_BLINK == TASK_ACTUATOR_DTA_EVENT(index)))
 				{
-					p_task_actuator_dta->flag = false;
-					HAL_GPIO_WritePin(p_task_actuator_cfg->gpio_port, p_task_actuator_cfg->pin, p_task_actuator_cfg->led_on);
-					p_task_actuator_dta->state = ST_LED_XX_ON;
+					TASK_ACTUATOR_DTA_FLAG_CLR(index);
+					task_actuator_led_blink(index, p_task_actuator_cfg);
+					TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_BLINK_ON;
+				}
+				else if ((true == TASK_ACTUATOR_DTA_FLAG(index)) && (EV_LED_XX_PULSE == TASK_ACTUATOR_DTA_EVENT(index)))
+				{
+					TASK_ACTUATOR_DTA_FLAG_CLR(index);
+					task_actuator_led_pulse(index, p_task_actuator_cfg);
+					TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_PULSE;
+				}
+				else if ((true == TASK_ACTUATOR_DTA_FLAG(index)) && (EV_LED_XX_PATTERN == TASK_ACTUATOR_DTA_EVENT(index)))
+				{
+					TASK_ACTUATOR_DTA_FLAG_CLR(index);
+					if (true == task_actuator_led_pattern(index, p_task_actuator_cfg))
+						TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_PATTERN;
 				}
 
 				break;
 
 			case ST_LED_XX_ON:
 
-				if ((true == p_task_actuator_dta->flag) && (EV_LED_XX_OFF == p_task_actuator_dta->event))
+				if ((true == TASK_ACTUATOR_DTA_FLAG(index)) && (EV_LED_XX_OFF == TASK_ACTUATOR_DTA_EVENT(index)))
 				{
-					p_task_actuator_dta->flag = false;
-					HAL_GPIO_WritePin(p_task_actuator_cfg->gpio_port, p_task_actuator_cfg->pin, p_task_actuator_cfg->led_off);
-					p_task_actuator_dta->state = ST_LED_XX_OFF;
+					TASK_ACTUATOR_DTA_FLAG_CLR(index);
+					task_actuator_led_off(p_task_actuator_cfg);
+					TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_OFF;
+				}
+				else if ((true == TASK_ACTUATOR_DTA_FLAG(index)) && (EV_LED_XX_PATTERN == TASK_ACTUATOR_DTA_EVENT(index)))
+				{
+					TASK_ACTUATOR_DTA_FLAG_CLR(index);
+					if (true == task_actuator_led_pattern(index, p_task_actuator_cfg))
+						TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_PATTERN;
 				}
 
 				break;
 
 			case ST_LED_XX_BLINK_ON:
+			case ST_LED_XX_BLINK_OFF:
+
+				if ((true == TASK_ACTUATOR_DTA_FLAG(index)) && (EV_LED_XX_OFF == TASK_ACTUATOR_DTA_EVENT(index)))
+				{
+					TASK_ACTUATOR_DTA_FLAG_CLR(index);
+					task_actuator_led_off(p_task_actuator_cfg);
+					TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_OFF;
+				}
+				else if ((true == TASK_ACTUATOR_DTA_FLAG(index)) && (EV_LED_XX_ON == TASK_ACTUATOR_DTA_EVENT(index)))
+				{
+					TASK_ACTUATOR_DTA_FLAG_CLR(index);
+					task_actuator_led_on(p_task_actuator_cfg);
+					TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_ON;
+				}
+				else if ((true == TASK_ACTUATOR_DTA_FLAG(index)) && (EV_LED_XX_PATTERN == TASK_ACTUATOR_DTA_EVENT(index)))
+				{
+					TASK_ACTUATOR_DTA_FLAG_CLR(index);
+					if (true == task_actuator_led_pattern(index, p_task_actuator_cfg))
+						TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_PATTERN;
+				}
+				else if (KIND_LED_XX_TIM == p_task_actuator_cfg->kind)
+				{
+					/* Blinking in hardware: nothing to do per tick */
+				}
+				else if (DEL_LED_XX_MIN < TASK_ACTUATOR_DTA_TICK(index))
+				{
+					TASK_ACTUATOR_DTA_TICK(index)--;
+				}
+				else if (ST_LED_XX_BLINK_ON == TASK_ACTUATOR_DTA_STATE(index))
+				{
+					TASK_ACTUATOR_DTA_TICK(index) = p_task_actuator_cfg->tick_blink;
+					task_actuator_led_off(p_task_actuator_cfg);
+					TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_BLINK_OFF;
+				}
+				else
+				{
+					TASK_ACTUATOR_DTA_TICK(index) = p_task_actuator_cfg->tick_blink;
+					task_actuator_led_on(p_task_actuator_cfg);
+					TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_BLINK_ON;
+				}
 
 				break;
 
-			case ST_LED_XX_BLINK_OFF:
+			case ST_LED_XX_PULSE:
+
+				if (TIMER_SERVICE_NONE != task_actuator_pulse_timer[index])
+				{
+					/* One-shot pending: the pulse ends above, no tick to count */
+				}
+				else if (KIND_LED_XX_TIM == p_task_actuator_cfg->kind)
+				{
+					/* No timer free: the one-pulse counter stops by itself, polled */
+					if (false == task_actuator_tim_busy(p_task_actuator_cfg))
+						TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_OFF;
+				}
+				else if (DEL_LED_XX_MIN < TASK_ACTUATOR_DTA_TICK(index))
+				{
+					TASK_ACTUATOR_DTA_TICK(index)--;
+				}
+				else
+				{
+					TASK_ACTUATOR_DTA_TICK(index) = p_task_actuator_cfg->tick_pulse;
+					task_actuator_led_off(p_task_actuator_cfg);
+					TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_OFF;
+				}
 
 				break;
 
-			case ST_LED_XX_PULSE:
+			case ST_LED_XX_PATTERN:
+
+				/* Steps are played from the deadline heap above */
+				if ((true == TASK_ACTUATOR_DTA_FLAG(index)) && (EV_LED_XX_OFF == TASK_ACTUATOR_DTA_EVENT(index)))
+				{
+					TASK_ACTUATOR_DTA_FLAG_CLR(index);
+					task_actuator_pattern_stop(index);
+					task_actuator_led_off(p_task_actuator_cfg);
+					TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_OFF;
+				}
+				else if ((true == TASK_ACTUATOR_DTA_FLAG(index)) && (EV_LED_XX_ON == TASK_ACTUATOR_DTA_EVENT(index)))
+				{
+					TASK_ACTUATOR_DTA_FLAG_CLR(index);
+					task_actuator_pattern_stop(index);
+					task_actuator_led_on(p_task_actuator_cfg);
+					TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_ON;
+				}
+				else if ((true == TASK_ACTUATOR_DTA_FLAG(index)) && (EV_LED_XX_BLINK == TASK_ACTUATOR_DTA_EVENT(index)))
+				{
+					TASK_ACTUATOR_DTA_FLAG_CLR(index);
+					task_actuator_pattern_stop(index);
+					task_actuator_led_blink(index, p_task_actuator_cfg);
+					TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_BLINK_ON;
+				}
+				else if ((true == TASK_ACTUATOR_DTA_FLAG(index)) && (EV_LED_XX_PULSE == TASK_ACTUATOR_DTA_EVENT(index)))
+				{
+					TASK_ACTUATOR_DTA_FLAG_CLR(index);
+					task_actuator_pattern_stop(index);
+					task_actuator_led_pulse(index, p_task_actuator_cfg);
+					TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_PULSE;
+				}
+				else if ((true == TASK_ACTUATOR_DTA_FLAG(index)) && (EV_LED_XX_PATTERN == TASK_ACTUATOR_DTA_EVENT(index)))
+				{
+					TASK_ACTUATOR_DTA_FLAG_CLR(index);
+					task_actuator_led_pattern(index, p_task_actuator_cfg);
+				}
 
 				break;
 
 			default:
 
-				p_task_actuator_dta->tick  = DEL_LED_XX_MIN;
-				p_task_actuator_dta->state = ST_LED_XX_OFF;
-				p_task_actuator_dta->event = EV_LED_XX_OFF;
-				p_task_actuator_dta->flag = false;
+				if (TIMER_SERVICE_NONE != task_actuator_pulse_timer[index])
+				{
+					timer_service_cancel(task_actuator_pulse_timer[index]);
+					task_actuator_pulse_timer[index] = TIMER_SERVICE_NONE;
+				}
+				TASK_ACTUATOR_DTA_TICK(index) = DEL_LED_XX_MIN;
+				TASK_ACTUATOR_DTA_STATE(index) = ST_LED_XX_OFF;
+				TASK_ACTUATOR_DTA_EVENT(index) = EV_LED_XX_OFF;
+				TASK_ACTUATOR_DTA_FLAG_CLR(index);
 
 				break;
 		}
+
+		if ((true == b_event) && (false == TASK_ACTUATOR_DTA_FLAG(index)))
+		{
+			TRACE_EVENT_GET(TRACE_QUEUE_ACTUATOR, (index << 8) | event);
+			E2E_ACTUATOR_TAKE(index);
+		}
+		else if ((true == b_event) && (ST_LED_XX_PULSE != state))
+		{
+			/* Not taken in this state: consumed & counted, never left pending
+			 * (a pulse defers its events to its end) */
+			TASK_ACTUATOR_DTA_FLAG_CLR(index);
+			g_task_actuator_ev_dropped++;
+			TRACE_EVENT_GET(TRACE_QUEUE_ACTUATOR, (index << 8) | event);
+		}
+		TRACE_STATE(TRACE_FSM_ACTUATOR, index, state, TASK_ACTUATOR_DTA_STATE(index));
+
+		if (true == task_actuator_settled(index, p_task_actuator_cfg))
+			TASK_ACTUATOR_DTA_ACTIVE_CLR(index);
+	}
+}
+
+void task_actuator_led_on(const task_actuator_cfg_t *p_task_actuator_cfg)
+{
+	task_actuator_led_level(p_task_actuator_cfg, p_task_actuator_cfg->brightness);
+}
+
+void task_actuator_led_off(const task_actuator_cfg_t *p_task_actuator_cfg)
+{
+	task_actuator_led_level(p_task_actuator_cfg, 0);
+}
+
+void task_actuator_led_blink(uint32_t index, const task_actuator_cfg_t *p_task_actuator_cfg)
+{
+	TASK_ACTUATOR_DTA_TICK(index) = p_task_actuator_cfg->tick_blink;
+
+	if (KIND_LED_XX_TIM == p_task_actuator_cfg->kind)
+		task_actuator_tim_blink(p_task_actuator_cfg);
+	else
+		task_actuator_led_on(p_task_actuator_cfg);
+}
+
+void task_actuator_led_pulse(uint32_t index, const task_actuator_cfg_t *p_task_actuator_cfg)
+{
+	uint32_t tick = p_task_actuator_cfg->tick_pulse;
+
+	TASK_ACTUATOR_DTA_TICK(index) = tick;
+
+	/* TIM: the one-pulse counter shapes the pulse, it starts one count late &
+	 * stops by itself, the one-shot only ends the state one tick later */
+	if (KIND_LED_XX_TIM == p_task_actuator_cfg->kind)
+	{
+		task_actuator_tim_pulse(p_task_actuator_cfg);
+		tick++;
 	}
+
+	/* End of pulse on a one-shot, tick counting (or polling) when none is free */
+	task_actuator_pulse_timer[index] = TIMER_SERVICE_NONE;
+	if ((INT32_MAX / TASK_ACT_TICK_US) >= tick)
+		task_actuator_pulse_timer[index] = (uint8_t)timer_service_add(tick * TASK_ACT_TICK_US, 0,
+																	  task_actuator_pulse_elapsed, (void *)(uintptr_t)index);
+
+	if (KIND_LED_XX_TIM != p_task_actuator_cfg->kind)
+		task_actuator_led_on(p_task_actuator_cfg);
+}
+
+/* timer_service callback (TIM2 interrupt): the statechart turns the actuator off */
+void task_actuator_pulse_elapsed(void *p_arg)
+{
+	uint32_t index = (uint32_t)(uintptr_t)p_arg;
+
+	bitmap_set((uint32_t *)task_actuator_pulse_end, index);
+}
+
+void task_actuator_led_level(const task_actuator_cfg_t *p_task_actuator_cfg, uint32_t level)
+{
+	switch (p_task_actuator_cfg->kind)
+	{
+		case KIND_LED_XX_TIM:
+
+			task_actuator_tim_level(p_task_actuator_cfg, level);
+
+			break;
+
+		case KIND_LED_XX_BAM:
+
+			/* Slot attached by table index (task_actuator_init()), not by identifier */
+			task_actuator_bam_level((uint32_t)(p_task_actuator_cfg - task_actuator_cfg_list), level);
+
+			break;
+
+		case KIND_LED_XX_GPIO:
+		default:
+
+			gpio_stage_write(p_task_actuator_cfg->gpio_port, p_task_actuator_cfg->pin,
+							 (0 < level) ? p_task_actuator_cfg->led_on : p_task_actuator_cfg->led_off);
+
+			break;
+	}
+}
+
+bool task_actuator_settled(uint32_t index, const task_actuator_cfg_t *p_task_actuator_cfg)
+{
+	/* Ended by the one-shot, no tick to count: a pending event waits for it */
+	if ((ST_LED_XX_PULSE == TASK_ACTUATOR_DTA_STATE(index)) && (TIMER_SERVICE_NONE != task_actuator_pulse_timer[index]))
+		return true;
+
+	/* Event pending: keep it active */
+	if (true == TASK_ACTUATOR_DTA_FLAG(index))
+		return false;
+
+	switch (TASK_ACTUATOR_DTA_STATE(index))
+	{
+		case ST_LED_XX_OFF:
+		case ST_LED_XX_ON:
+		case ST_LED_XX_PATTERN:		/* steps come from the deadline heap */
+
+			return true;
+
+		case ST_LED_XX_BLINK_ON:
+		case ST_LED_XX_BLINK_OFF:
+
+			/* Blinking in hardware, no tick to count */
+			return (KIND_LED_XX_TIM == p_task_actuator_cfg->kind);
+
+		default:
+
+			return false;
+	}
+}
+
+bool task_actuator_led_pattern(uint32_t index, const task_actuator_cfg_t *p_task_actuator_cfg)
+{
+	uint32_t level;
+
+	if (false == task_actuator_pattern_start(index, g_task_actuator_cnt, &level))
+		return false;
+
+	task_actuator_led_level(p_task_actuator_cfg, level);
+
+	return true;
 }
 
 /********************** end of file ******************************************/
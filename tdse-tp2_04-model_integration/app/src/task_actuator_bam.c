@@ -0,0 +1,272 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : task_actuator_bam.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+/********************** inclusions *******************************************/
+/* Project includes */
+#include "main.h"
+
+/* Demo includes */
+#define LOGGER_MODULE			LOGGER_MODULE_TASK_ACTUATOR
+#include "logger.h"
+#include "dwt.h"
+#include "gpio_stage.h"
+
+/* Application & Tasks includes */
+#include "board.h"
+#include "app.h"
+#include "task_actuator_attribute.h"
+#include "task_actuator_tim.h"
+#include "task_actuator_bam.h"
+
+/********************** macros and definitions *******************************/
+#define BAM_LEVEL_MAX		((1ul << TASK_ACTUATOR_BAM_BITS) - 1)
+#define BAM_PORT(index)		((GPIO_TypeDef *)(GPIOA_BASE + ((index) * GPIO_STAGE_PORT_STRIDE)))
+
+/********************** internal data declaration ****************************/
+typedef struct
+{
+	const task_actuator_cfg_t *p_cfg;
+	uint8_t		level;
+} task_actuator_bam_dta_t;
+
+/********************** internal functions declaration ***********************/
+
+/********************** internal data definition *****************************/
+task_actuator_bam_dta_t task_actuator_bam_dta_list[TASK_ACTUATOR_BAM_QTY_MAX];
+
+/* Double-buffered BSRR words per bit & port: ISR reads [front], task writes [front ^ 1] */
+uint32_t task_actuator_bam_bsrr[2][TASK_ACTUATOR_BAM_BITS][GPIO_STAGE_PORT_QTY];
+volatile uint32_t task_actuator_bam_front;
+volatile bool task_actuator_bam_swap;
+bool task_actuator_bam_dirty;
+
+/* Ports in use (fixed once started), current bit & counts per unit */
+uint32_t task_actuator_bam_ports;
+uint32_t task_actuator_bam_bit;
+uint32_t task_actuator_bam_unit;
+
+/********************** external data declaration ****************************/
+task_actuator_bam_stats_t task_actuator_bam_stats;
+
+/********************** external functions definition ************************/
+void task_actuator_bam_init(void)
+{
+	uint32_t index;
+
+	for (index = 0; TASK_ACTUATOR_BAM_QTY_MAX > index; index++)
+	{
+		task_actuator_bam_dta_list[index].p_cfg = NULL;
+		task_actuator_bam_dta_list[index].level = 0;
+	}
+
+	memset(task_actuator_bam_bsrr, 0, sizeof(task_actuator_bam_bsrr));
+	memset(&task_actuator_bam_stats, 0, sizeof(task_actuator_bam_stats));
+	task_actuator_bam_front = 0;
+	task_actuator_bam_swap = false;
+	task_actuator_bam_dirty = false;
+	task_actuator_bam_ports = 0;
+	task_actuator_bam_bit = 0;
+}
+
+void task_actuator_bam_attach(uint32_t index, const task_actuator_cfg_t *p_cfg)
+{
+	GPIO_InitTypeDef gpio_init = {0};
+
+	if (TASK_ACTUATOR_BAM_QTY_MAX <= index)
+	{
+		LOGGER_ERROR("   %s: actuator %lu above TASK_ACTUATOR_BAM_QTY_MAX", GET_NAME(task_actuator_bam_attach), index);
+		return;
+	}
+
+	task_actuator_bam_dta_list[index].p_cfg = p_cfg;
+	task_actuator_bam_dta_list[index].level = 0;
+	task_actuator_bam_ports |= (1ul << GPIO_STAGE_PORT_INDEX(p_cfg->gpio_port));
+	task_actuator_bam_dirty = true;
+
+	task_actuator_bam_stats.led_qty++;
+	task_actuator_bam_stats.port_qty = (uint32_t)__builtin_popcount(task_actuator_bam_ports);
+
+	HAL_GPIO_WritePin(p_cfg->gpio_port, p_cfg->pin, p_cfg->led_off);
+	gpio_init.Pin = p_cfg->pin;
+	gpio_init.Mode = GPIO_MODE_OUTPUT_PP;
+	gpio_init.Speed = GPIO_SPEED_FREQ_LOW;
+	HAL_GPIO_Init(p_cfg->gpio_port, &gpio_init);
+}
+
+void task_actuator_bam_start(void)
+{
+	TIM_TypeDef *tim = TASK_ACTUATOR_BAM_TIM;
+
+	if (0 == task_actuator_bam_stats.led_qty)
+		return;
+
+	/* One unit = 1 / (FREQ_HZ * (2^BITS - 1)) S */
+	task_actuator_bam_unit = TASK_ACTUATOR_BAM_CNT_HZ / (TASK_ACTUATOR_BAM_FREQ_HZ * BAM_LEVEL_MAX);
+	if (0 == task_actuator_bam_unit)
+		task_actuator_bam_unit = 1;
+
+	__HAL_RCC_TIM4_CLK_ENABLE();
+
+	/* ARR preloaded: the ISR of bit b writes the length of bit b + 1.
+	 * URS: only the counter overflow raises the update interrupt, not UG */
+	tim->CR1 = TIM_CR1_ARPE | TIM_CR1_URS;
+	tim->PSC = (task_actuator_tim_clk(tim) / TASK_ACTUATOR_BAM_CNT_HZ) - 1;
+	tim->ARR = task_actuator_bam_unit - 1;
+	tim->EGR = TIM_EGR_UG;
+	tim->ARR = (task_actuator_bam_unit << 1) - 1;
+	tim->SR = 0;
+	tim->DIER = TIM_DIER_UIE;
+
+	HAL_NVIC_SetPriority(TASK_ACTUATOR_BAM_IRQn, TASK_ACTUATOR_BAM_IRQ_PRIO, 0);
+	HAL_NVIC_EnableIRQ(TASK_ACTUATOR_BAM_IRQn);
+
+	tim->CR1 |= TIM_CR1_CEN;
+
+	LOGGER_INFO("   %s: %lu LEDs on %lu ports, %lu bits @ %lu Hz",
+				 GET_NAME(task_actuator_bam_start), task_actuator_bam_stats.led_qty,
+				 task_actuator_bam_stats.port_qty, TASK_ACTUATOR_BAM_BITS, TASK_ACTUATOR_BAM_FREQ_HZ);
+}
+
+void task_actuator_bam_level(uint32_t index, uint32_t level)
+{
+	uint8_t bam_level;
+
+	if ((TASK_ACTUATOR_BAM_QTY_MAX <= index) || (NULL == task_actuator_bam_dta_list[index].p_cfg))
+		return;
+
+	if (LED_XX_BRIGHTNESS_MAX < level)
+		level = LED_XX_BRIGHTNESS_MAX;
+
+	bam_level = (uint8_t)(((level * BAM_LEVEL_MAX) + (LED_XX_BRIGHTNESS_MAX / 2)) / LED_XX_BRIGHTNESS_MAX);
+
+	if (bam_level != task_actuator_bam_dta_list[index].level)
+	{
+		task_actuator_bam_dta_list[index].level = bam_level;
+		task_actuator_bam_dirty = true;
+	}
+}
+
+void task_actuator_bam_update(void)
+{
+	uint32_t (*p_bsrr)[GPIO_STAGE_PORT_QTY];
+	const task_actuator_cfg_t *p_cfg;
+	uint32_t index, bit, port, pin;
+	bool b_on;
+
+	/* Nothing new, or the ISR has not taken the previous masks yet */
+	if ((false == task_actuator_bam_dirty) || (true == task_actuator_bam_swap))
+		return;
+
+	p_bsrr = task_actuator_bam_bsrr[task_actuator_bam_front ^ 1];
+	memset(p_bsrr, 0, sizeof(task_actuator_bam_bsrr[0]));
+
+	for (index = 0; TASK_ACTUATOR_BAM_QTY_MAX > index; index++)
+	{
+		p_cfg = task_actuator_bam_dta_list[index].p_cfg;
+		if (NULL == p_cfg)
+			continue;
+
+		port = GPIO_STAGE_PORT_INDEX(p_cfg->gpio_port);
+
+		for (bit = 0; TASK_ACTUATOR_BAM_BITS > bit; bit++)
+		{
+			b_on = (0 != (task_actuator_bam_dta_list[index].level & (1u << bit)));
+			pin = p_cfg->pin;
+
+			/* Pin level for this bit, with the actuator polarity */
+			if (b_on == (GPIO_PIN_SET == p_cfg->led_on))
+				p_bsrr[bit][port] |= pin;
+			else
+				p_bsrr[bit][port] |= (pin << 16);
+		}
+	}
+
+	task_actuator_bam_dirty = false;
+
+	/* Masks written before the ISR can see the swap request */
+	__DMB();
+	task_actuator_bam_swap = true;
+}
+
+void task_actuator_bam_isr(void)
+{
+	TIM_TypeDef *tim = TASK_ACTUATOR_BAM_TIM;
+	uint32_t cycles = cycle_counter_get();
+	const uint32_t *p_bsrr;
+	uint32_t bit, next, ports, port;
+
+	tim->SR = ~(uint32_t)TIM_SR_UIF;
+
+	/* Bit of the slice that starts now */
+	bit = task_actuator_bam_bit + 1;
+	if (TASK_ACTUATOR_BAM_BITS <= bit)
+	{
+		bit = 0;
+		task_actuator_bam_stats.period_cnt++;
+
+		/* New masks only at a period boundary */
+		if (true == task_actuator_bam_swap)
+		{
+			task_actuator_bam_front ^= 1;
+			task_actuator_bam_swap = false;
+		}
+	}
+	task_actuator_bam_bit = bit;
+
+	/* One BSRR write per port in use */
+	p_bsrr = task_actuator_bam_bsrr[task_actuator_bam_front][bit];
+	ports = task_actuator_bam_ports;
+	while (0 != ports)
+	{
+		port = (uint32_t)__builtin_ctz(ports);
+		ports &= ports - 1;
+		BAM_PORT(port)->BSRR = p_bsrr[port];
+	}
+
+	/* Length of the next slice, loaded by hardware at the next update */
+	next = bit + 1;
+	if (TASK_ACTUATOR_BAM_BITS <= next)
+		next = 0;
+	tim->ARR = (task_actuator_bam_unit << next) - 1;
+
+	cycles = cycle_counter_get() - cycles;
+	task_actuator_bam_stats.isr_cycles_last = cycles;
+	if (task_actuator_bam_stats.isr_cycles_max < cycles)
+		task_actuator_bam_stats.isr_cycles_max = cycles;
+}
+
+/********************** end of file ******************************************/
@@ -41,13 +41,20 @@
 #include "main.h"
 
 /* Demo includes */
+#define LOGGER_MODULE			LOGGER_MODULE_TASK_ACTUATOR
 #include "logger.h"
 #include "dwt.h"
+#include "bitmap.h"
+#include "trace.h"
+#include "latency.h"
+#include "e2e_latency.h"
 
 /* Application & Tasks includes */
 #include "board.h"
 #include "app.h"
 #include "task_actuator_attribute.h"
+#include "task_actuator_interface.h"
+#include "task_actuator_pattern.h"
 
 /********************** macros and definitions *******************************/
 
@@ -62,12 +69,22 @@
 /********************** external functions definition ************************/
 void put_event_task_actuator(task_actuator_ev_t event, task_actuator_id_t identifier)
 {
-	task_actuator_dta_t *p_task_actuator_dta;
+	/* task_actuator_cfg_list[] rows are in identifier order (task_actuator_init()):
+	 * the table index keys the data, the e2e mailbox & the trace as in task_actuator_update() */
+	uint32_t index = (uint32_t)identifier;
 
-	p_task_actuator_dta = &task_actuator_dta_list[identifier];
+	TASK_ACTUATOR_DTA_EVENT(index) = event;
+	TASK_ACTUATOR_DTA_FLAG_SET(index);
+	TASK_ACTUATOR_DTA_ACTIVE_SET(index);
+	E2E_ACTUATOR_PUT(index, event);
 
-	p_task_actuator_dta->event = event;
-	p_task_actuator_dta->flag = true;
+	TRACE_EVENT_PUT(TRACE_QUEUE_ACTUATOR, (index << 8) | (uint32_t)event);
+}
+
+void put_event_task_actuator_pattern(task_actuator_pattern_id_t pattern, task_actuator_id_t identifier)
+{
+	task_actuator_pattern_request(identifier, pattern);
+	put_event_task_actuator(EV_LED_XX_PATTERN, identifier);
 }
 
 /********************** end of file ******************************************/
@@ -0,0 +1,314 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : task_actuator_pattern.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+/********************** inclusions *******************************************/
+/* Project includes */
+#include "main.h"
+
+/* Demo includes */
+#define LOGGER_MODULE			LOGGER_MODULE_TASK_ACTUATOR
+#include "logger.h"
+
+/* Application & Tasks includes */
+#include "board.h"
+#include "app.h"
+#include "task_actuator_attribute.h"
+#include "task_actuator_pattern.h"
+
+/********************** macros and definitions *******************************/
+#define PAT_ON		LED_XX_BRIGHTNESS_MAX
+#define PAT_OFF		0
+
+#define PAT_QTY(steps)	(sizeof(steps)/sizeof(task_actuator_pattern_step_t))
+
+#define HEAP_POS_NONE	0xFFFFu
+
+#if (TASK_ACTUATOR_PATTERN_QTY_MAX >= HEAP_POS_NONE)
+#error "TASK_ACTUATOR_PATTERN_QTY_MAX exceeds the 16-bit heap positions"
+#endif
+
+/********************** internal data declaration ****************************/
+typedef struct
+{
+	const task_actuator_pattern_t *p_pattern;
+	uint32_t	deadline;
+	uint16_t	step;
+	uint16_t	heap_pos;
+	uint8_t		request;
+} task_actuator_pattern_dta_t;
+
+/* SOS: dot 200 mS, dash 600 mS, gap 200 mS, letter gap 600 mS, word gap 1400 mS */
+const task_actuator_pattern_step_t task_actuator_pattern_sos[] = {
+	{PAT_ON, 20}, {PAT_OFF, 20}, {PAT_ON, 20}, {PAT_OFF, 20}, {PAT_ON, 20}, {PAT_OFF, 60},
+	{PAT_ON, 60}, {PAT_OFF, 20}, {PAT_ON, 60}, {PAT_OFF, 20}, {PAT_ON, 60}, {PAT_OFF, 60},
+	{PAT_ON, 20}, {PAT_OFF, 20}, {PAT_ON, 20}, {PAT_OFF, 20}, {PAT_ON, 20}, {PAT_OFF, 140}
+};
+
+/* Fault codes: n blinks of 300 mS, then 1500 mS off */
+const task_actuator_pattern_step_t task_actuator_pattern_fault_2[] = {
+	{PAT_ON, 30}, {PAT_OFF, 30}, {PAT_ON, 30}, {PAT_OFF, 150}
+};
+
+const task_actuator_pattern_step_t task_actuator_pattern_fault_3[] = {
+	{PAT_ON, 30}, {PAT_OFF, 30}, {PAT_ON, 30}, {PAT_OFF, 30}, {PAT_ON, 30}, {PAT_OFF, 150}
+};
+
+/* Breathing: 2 S period, brightness steps (on GPIO actuators: level > 0 => on) */
+const task_actuator_pattern_step_t task_actuator_pattern_breathing[] = {
+	{0, 10},  {5, 8},   {10, 8},  {20, 8},  {30, 8},  {45, 8},  {60, 8},  {80, 8},  {100, 14},
+	{80, 8},  {60, 8},  {45, 8},  {30, 8},  {20, 8},  {10, 8},  {5, 8}
+};
+
+/* Heartbeat: lub-dub, then rest */
+const task_actuator_pattern_step_t task_actuator_pattern_heartbeat[] = {
+	{PAT_ON, 10}, {PAT_OFF, 15}, {PAT_ON, 10}, {PAT_OFF, 65}
+};
+
+/* Indexed by task_actuator_pattern_id_t */
+const task_actuator_pattern_t task_actuator_pattern_list[] = {
+	{task_actuator_pattern_sos,			PAT_QTY(task_actuator_pattern_sos),			true},
+	{task_actuator_pattern_fault_2,		PAT_QTY(task_actuator_pattern_fault_2),		true},
+	{task_actuator_pattern_fault_3,		PAT_QTY(task_actuator_pattern_fault_3),		true},
+	{task_actuator_pattern_breathing,	PAT_QTY(task_actuator_pattern_breathing),	true},
+	{task_actuator_pattern_heartbeat,	PAT_QTY(task_actuator_pattern_heartbeat),	true}
+};
+
+#define PATTERN_QTY	(sizeof(task_actuator_pattern_list)/sizeof(task_actuator_pattern_t))
+
+/********************** internal functions declaration ***********************/
+static bool task_actuator_pattern_before_(uint32_t index_a, uint32_t index_b);
+static void task_actuator_pattern_heap_place_(uint32_t pos, uint32_t index);
+static void task_actuator_pattern_heap_up_(uint32_t pos);
+static void task_actuator_pattern_heap_down_(uint32_t pos);
+static void task_actuator_pattern_heap_remove_(uint32_t index);
+
+/********************** internal data definition *****************************/
+static task_actuator_pattern_dta_t task_actuator_pattern_dta_list_[TASK_ACTUATOR_PATTERN_QTY_MAX];
+
+/* Min-heap of playing actuators, ordered by deadline (shared time base) */
+static uint16_t task_actuator_pattern_heap_[TASK_ACTUATOR_PATTERN_QTY_MAX];
+static uint32_t task_actuator_pattern_heap_qty_;
+
+/********************** external data declaration ****************************/
+
+/********************** external functions definition ************************/
+void task_actuator_pattern_init(void)
+{
+	uint32_t index;
+
+	task_actuator_pattern_heap_qty_ = 0;
+
+	for (index = 0; TASK_ACTUATOR_PATTERN_QTY_MAX > index; index++)
+	{
+		task_actuator_pattern_dta_list_[index].p_pattern = NULL;
+		task_actuator_pattern_dta_list_[index].deadline = 0;
+		task_actuator_pattern_dta_list_[index].step = 0;
+		task_actuator_pattern_dta_list_[index].request = PATTERN_LED_XX_SOS;
+		task_actuator_pattern_dta_list_[index].heap_pos = HEAP_POS_NONE;
+	}
+}
+
+void task_actuator_pattern_request(uint32_t index, task_actuator_pattern_id_t pattern)
+{
+	if (TASK_ACTUATOR_PATTERN_QTY_MAX > index)
+	{
+		task_actuator_pattern_dta_list_[index].request = (uint8_t)pattern;
+	}
+}
+
+bool task_actuator_pattern_start(uint32_t index, uint32_t now, uint32_t *p_level)
+{
+	task_actuator_pattern_dta_t *p_dta;
+
+	if ((TASK_ACTUATOR_PATTERN_QTY_MAX <= index) ||
+		(PATTERN_QTY <= task_actuator_pattern_dta_list_[index].request))
+	{
+		return false;
+	}
+
+	p_dta = &task_actuator_pattern_dta_list_[index];
+
+	/* Restart if already playing */
+	task_actuator_pattern_heap_remove_(index);
+
+	p_dta->p_pattern = &task_actuator_pattern_list[p_dta->request];
+	p_dta->step = 0;
+	p_dta->deadline = now + (p_dta->p_pattern->p_step[0].dur * TASK_ACTUATOR_PATTERN_TICK);
+
+	task_actuator_pattern_heap_place_(task_actuator_pattern_heap_qty_, index);
+	task_actuator_pattern_heap_qty_++;
+	task_actuator_pattern_heap_up_(task_actuator_pattern_heap_qty_ - 1);
+
+	*p_level = p_dta->p_pattern->p_step[0].level;
+
+	return true;
+}
+
+void task_actuator_pattern_stop(uint32_t index)
+{
+	if (TASK_ACTUATOR_PATTERN_QTY_MAX > index)
+	{
+		task_actuator_pattern_heap_remove_(index);
+	}
+}
+
+bool task_actuator_pattern_next(uint32_t now, uint32_t *p_index, uint32_t *p_level, bool *p_end)
+{
+	task_actuator_pattern_dta_t *p_dta;
+	uint32_t index;
+
+	if (0 == task_actuator_pattern_heap_qty_)
+	{
+		return false;
+	}
+
+	index = task_actuator_pattern_heap_[0];
+	p_dta = &task_actuator_pattern_dta_list_[index];
+
+	/* Earliest deadline not reached (wrap-safe) */
+	if (0 < (int32_t)(p_dta->deadline - now))
+	{
+		return false;
+	}
+
+	*p_index = index;
+	*p_end = false;
+
+	p_dta->step++;
+	if (p_dta->p_pattern->qty <= p_dta->step)
+	{
+		if (false == p_dta->p_pattern->repeat)
+		{
+			task_actuator_pattern_heap_remove_(index);
+			*p_level = PAT_OFF;
+			*p_end = true;
+			return true;
+		}
+		p_dta->step = 0;
+	}
+
+	/* Next deadline from the previous one: no drift */
+	p_dta->deadline += p_dta->p_pattern->p_step[p_dta->step].dur * TASK_ACTUATOR_PATTERN_TICK;
+	task_actuator_pattern_heap_down_(0);
+
+	*p_level = p_dta->p_pattern->p_step[p_dta->step].level;
+
+	return true;
+}
+
+/********************** internal functions definition ************************/
+static bool task_actuator_pattern_before_(uint32_t index_a, uint32_t index_b)
+{
+	return (0 > (int32_t)(task_actuator_pattern_dta_list_[index_a].deadline -
+						  task_actuator_pattern_dta_list_[index_b].deadline));
+}
+
+static void task_actuator_pattern_heap_place_(uint32_t pos, uint32_t index)
+{
+	task_actuator_pattern_heap_[pos] = (uint16_t)index;
+	task_actuator_pattern_dta_list_[index].heap_pos = (uint16_t)pos;
+}
+
+static void task_actuator_pattern_heap_up_(uint32_t pos)
+{
+	uint32_t index = task_actuator_pattern_heap_[pos];
+	uint32_t parent;
+
+	while (0 < pos)
+	{
+		parent = (pos - 1) / 2;
+		if (false == task_actuator_pattern_before_(index, task_actuator_pattern_heap_[parent]))
+		{
+			break;
+		}
+		task_actuator_pattern_heap_place_(pos, task_actuator_pattern_heap_[parent]);
+		pos = parent;
+	}
+	task_actuator_pattern_heap_place_(pos, index);
+}
+
+static void task_actuator_pattern_heap_down_(uint32_t pos)
+{
+	uint32_t index = task_actuator_pattern_heap_[pos];
+	uint32_t child;
+
+	for (;;)
+	{
+		child = (2 * pos) + 1;
+		if (task_actuator_pattern_heap_qty_ <= child)
+		{
+			break;
+		}
+		if (((child + 1) < task_actuator_pattern_heap_qty_) &&
+			task_actuator_pattern_before_(task_actuator_pattern_heap_[child + 1], task_actuator_pattern_heap_[child]))
+		{
+			child++;
+		}
+		if (false == task_actuator_pattern_before_(task_actuator_pattern_heap_[child], index))
+		{
+			break;
+		}
+		task_actuator_pattern_heap_place_(pos, task_actuator_pattern_heap_[child]);
+		pos = child;
+	}
+	task_actuator_pattern_heap_place_(pos, index);
+}
+
+static void task_actuator_pattern_heap_remove_(uint32_t index)
+{
+	uint32_t pos = task_actuator_pattern_dta_list_[index].heap_pos;
+	uint32_t last;
+
+	if (HEAP_POS_NONE == pos)
+	{
+		return;
+	}
+
+	task_actuator_pattern_dta_list_[index].heap_pos = HEAP_POS_NONE;
+	task_actuator_pattern_heap_qty_--;
+
+	if (pos < task_actuator_pattern_heap_qty_)
+	{
+		/* Move the last entry into the hole, then restore the heap order */
+		last = task_actuator_pattern_heap_[task_actuator_pattern_heap_qty_];
+		task_actuator_pattern_heap_place_(pos, last);
+		task_actuator_pattern_heap_up_(pos);
+		task_actuator_pattern_heap_down_(task_actuator_pattern_dta_list_[last].heap_pos);
+	}
+}
+
+/********************** end of file ******************************************/
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : task_actuator_tim.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+/********************** inclusions *******************************************/
+/* Project includes */
+#include "main.h"
+
+/* Demo includes */
+#define LOGGER_MODULE			LOGGER_MODULE_TASK_ACTUATOR
+#include "logger.h"
+
+/* Application & Tasks includes */
+#include "board.h"
+#include "app.h"
+#include "task_actuator_attribute.h"
+#include "task_actuator_tim.h"
+#include "task_actuator_bam.h"
+#include "timer_service.h"
+
+/********************** macros and definitions *******************************/
+#define TIM_CNT_CLK_HZ			10000ul		/* blink & pulse: 1 count = 0.1 mS	*/
+#define TIM_CNT_PER_MS			(TIM_CNT_CLK_HZ / 1000ul)
+#define TIM_CNT_CLK_US_HZ		1000000ul	/* dimming: 1 count = 1 uS			*/
+#define TIM_PWM_PERIOD_US		1000ul		/* dimming: 1 KHz					*/
+#define TIM_ARR_MAX				0xFFFFul
+
+/* Output compare modes (TIMx_CCMRy OCxM) */
+#define TIM_OCM_PWM1			6ul
+#define TIM_OCM_PWM2			7ul
+#define TIM_OCM_FORCE_INACTIVE	4ul
+#define TIM_OCM_FORCE_ACTIVE	5ul
+
+/********************** internal data declaration ****************************/
+
+/********************** internal functions declaration ***********************/
+bool task_actuator_tim_usable(const task_actuator_cfg_t *p_cfg);
+void task_actuator_tim_ocm(const task_actuator_cfg_t *p_cfg, uint32_t ocm);
+void task_actuator_tim_start(const task_actuator_cfg_t *p_cfg, uint32_t psc, uint32_t arr, uint32_t ccr, bool one_pulse);
+
+/********************** internal data definition *****************************/
+
+/********************** external data declaration ****************************/
+
+/********************** external functions definition ************************/
+bool task_actuator_tim_init(const task_actuator_cfg_t *p_cfg)
+{
+	GPIO_InitTypeDef gpio_init = {0};
+	TIM_TypeDef *tim = p_cfg->tim;
+	uint32_t shift = (p_cfg->tim_channel - 1) * 4;
+
+	if (false == task_actuator_tim_usable(p_cfg))
+	{
+		LOGGER_ERROR("   %s: TIM 0x%08lx channel %lu not usable (TIM2: timer_service, TIM4: BAM)",
+					 GET_NAME(task_actuator_tim_init), (uint32_t)(uintptr_t)tim, p_cfg->tim_channel);
+		return false;
+	}
+
+	/* Timer clock */
+	if (TIM1 == tim)
+		__HAL_RCC_TIM1_CLK_ENABLE();
+	else if (TIM3 == tim)
+		__HAL_RCC_TIM3_CLK_ENABLE();
+
+	/* Counter stopped, up-counting, no preload: PSC & ARR loaded by UG */
+	tim->CR1 = 0;
+	tim->DIER = 0;
+
+	/* Channel output forced inactive, polarity from led_on */
+	task_actuator_tim_ocm(p_cfg, TIM_OCM_FORCE_INACTIVE);
+	tim->CCER &= ~((TIM_CCER_CC1E | TIM_CCER_CC1P) << shift);
+	if (GPIO_PIN_RESET == p_cfg->led_on)
+		tim->CCER |= (TIM_CCER_CC1P << shift);
+	tim->CCER |= (TIM_CCER_CC1E << shift);
+
+	/* Advanced-control timer: main output enable */
+	if (TIM1 == tim)
+		tim->BDTR |= TIM_BDTR_MOE;
+
+	/* Pin driven by the timer channel */
+	gpio_init.Pin = p_cfg->pin;
+	gpio_init.Mode = GPIO_MODE_AF_PP;
+	gpio_init.Speed = GPIO_SPEED_FREQ_LOW;
+	HAL_GPIO_Init(p_cfg->gpio_port, &gpio_init);
+
+	LOGGER_INFO("   %s: TIM @ %lu Hz, channel %lu",
+				 GET_NAME(task_actuator_tim_init), task_actuator_tim_clk(tim), p_cfg->tim_channel);
+
+	return true;
+}
+
+void task_actuator_tim_on(const task_actuator_cfg_t *p_cfg)
+{
+	task_actuator_tim_level(p_cfg, p_cfg->brightness);
+}
+
+void task_actuator_tim_level(const task_actuator_cfg_t *p_cfg, uint32_t level)
+{
+	TIM_TypeDef *tim = p_cfg->tim;
+	uint32_t psc = (task_actuator_tim_clk(tim) / TIM_CNT_CLK_US_HZ) - 1;
+	uint32_t ccr = (level * TIM_PWM_PERIOD_US) / LED_XX_BRIGHTNESS_MAX;
+
+	/* Rejected by task_actuator_tim_init(): never touch the owner's timer */
+	if (false == task_actuator_tim_usable(p_cfg))
+		return;
+
+	if (0 == level)
+	{
+		task_actuator_tim_off(p_cfg);
+	}
+	else if (LED_XX_BRIGHTNESS_MAX <= level)
+	{
+		tim->CR1 &= ~TIM_CR1_CEN;
+		task_actuator_tim_ocm(p_cfg, TIM_OCM_FORCE_ACTIVE);
+	}
+	else if ((TIM_CR1_CEN == (tim->CR1 & (TIM_CR1_CEN | TIM_CR1_OPM))) && (psc == tim->PSC) &&
+			 ((TIM_PWM_PERIOD_US - 1) == tim->ARR))
+	{
+		/* Already dimming: change the duty only, no counter restart */
+		(&tim->CCR1)[p_cfg->tim_channel - 1] = ccr;
+	}
+	else
+	{
+		task_actuator_tim_ocm(p_cfg, TIM_OCM_PWM1);
+		task_actuator_tim_start(p_cfg, psc, TIM_PWM_PERIOD_US - 1, ccr, false);
+	}
+}
+
+void task_actuator_tim_off(const task_actuator_cfg_t *p_cfg)
+{
+	if (false == task_actuator_tim_usable(p_cfg))
+		return;
+
+	p_cfg->tim->CR1 &= ~TIM_CR1_CEN;
+	task_actuator_tim_ocm(p_cfg, TIM_OCM_FORCE_INACTIVE);
+}
+
+void task_actuator_tim_blink(const task_actuator_cfg_t *p_cfg)
+{
+	uint32_t tim_clk = task_actuator_tim_clk(p_cfg->tim);
+	uint32_t tick = p_cfg->tick_blink;
+
+	if (false == task_actuator_tim_usable(p_cfg))
+		return;
+
+	/* 16-bit ARR: up to 3276 mS on & off */
+	if (((TIM_ARR_MAX + 1) / (2 * TIM_CNT_PER_MS)) < tick)
+	{
+		LOGGER_WARN("   %s: blink %lu mS above the TIM range", GET_NAME(task_actuator_tim_blink), tick);
+		tick = (TIM_ARR_MAX + 1) / (2 * TIM_CNT_PER_MS);
+	}
+
+	/* Active while CNT < CCR: tick_blink mS on, tick_blink mS off */
+	task_actuator_tim_ocm(p_cfg, TIM_OCM_PWM1);
+	task_actuator_tim_start(p_cfg, (tim_clk / TIM_CNT_CLK_HZ) - 1, (2 * tick * TIM_CNT_PER_MS) - 1,
+							tick * TIM_CNT_PER_MS, false);
+}
+
+void task_actuator_tim_pulse(const task_actuator_cfg_t *p_cfg)
+{
+	uint32_t tim_clk = task_actuator_tim_clk(p_cfg->tim);
+	uint32_t tick = p_cfg->tick_pulse;
+
+	if (false == task_actuator_tim_usable(p_cfg))
+		return;
+
+	/* 16-bit ARR: up to 6553 mS */
+	if ((TIM_ARR_MAX / TIM_CNT_PER_MS) < tick)
+	{
+		LOGGER_WARN("   %s: pulse %lu mS above the TIM range", GET_NAME(task_actuator_tim_pulse), tick);
+		tick = TIM_ARR_MAX / TIM_CNT_PER_MS;
+	}
+
+	/* Active while CCR <= CNT <= ARR, the counter stops (CEN = 0, CNT = 0) at the update event */
+	task_actuator_tim_ocm(p_cfg, TIM_OCM_PWM2);
+	task_actuator_tim_start(p_cfg, (tim_clk / TIM_CNT_CLK_HZ) - 1, tick * TIM_CNT_PER_MS, 1, true);
+}
+
+bool task_actuator_tim_busy(const task_actuator_cfg_t *p_cfg)
+{
+	if (false == task_actuator_tim_usable(p_cfg))
+		return false;
+
+	return (0 != (p_cfg->tim->CR1 & TIM_CR1_CEN));
+}
+
+uint32_t task_actuator_tim_clk(const TIM_TypeDef *tim)
+{
+	/* TIMxCLK = PCLKx, or 2 x PCLKx when the APBx prescaler is not 1 */
+	if (TIM1 == tim)
+	{
+		if (RCC_CFGR_PPRE2_DIV1 == (RCC->CFGR & RCC_CFGR_PPRE2))
+			return HAL_RCC_GetPCLK2Freq();
+		return 2 * HAL_RCC_GetPCLK2Freq();
+	}
+
+	if (RCC_CFGR_PPRE1_DIV1 == (RCC->CFGR & RCC_CFGR_PPRE1))
+		return HAL_RCC_GetPCLK1Freq();
+	return 2 * HAL_RCC_GetPCLK1Freq();
+}
+
+/********************** internal functions definition ************************/
+bool task_actuator_tim_usable(const task_actuator_cfg_t *p_cfg)
+{
+	/* TIM2 & TIM4 have owners, their registers are reprogrammed from their ISRs */
+	if ((TIMER_SERVICE_TIM == p_cfg->tim) || (TASK_ACTUATOR_BAM_TIM == p_cfg->tim))
+		return false;
+
+	if ((TIM1 != p_cfg->tim) && (TIM3 != p_cfg->tim))
+		return false;
+
+	return ((1 <= p_cfg->tim_channel) && (4 >= p_cfg->tim_channel));
+}
+
+void task_actuator_tim_ocm(const task_actuator_cfg_t *p_cfg, uint32_t ocm)
+{
+	/* CCMR1 => channels 1 & 2, CCMR2 => channels 3 & 4, 8 bits each */
+	volatile uint32_t *p_ccmr = (p_cfg->tim_channel <= 2) ? &p_cfg->tim->CCMR1 : &p_cfg->tim->CCMR2;
+	uint32_t shift = ((p_cfg->tim_channel - 1) & 1) * 8;
+
+	*p_ccmr = (*p_ccmr & ~(TIM_CCMR1_OC1M << shift)) | ((ocm << TIM_CCMR1_OC1M_Pos) << shift);
+}
+
+void task_actuator_tim_start(const task_actuator_cfg_t *p_cfg, uint32_t psc, uint32_t arr, uint32_t ccr, bool one_pulse)
+{
+	TIM_TypeDef *tim = p_cfg->tim;
+
+	/* CCR1..CCR4 are consecutive registers */
+	tim->CR1 &= ~(TIM_CR1_CEN | TIM_CR1_OPM);
+	tim->PSC = psc;
+	tim->ARR = arr;
+	(&tim->CCR1)[p_cfg->tim_channel - 1] = ccr;
+
+	/* Load PSC (always buffered) and reset CNT */
+	tim->EGR = TIM_EGR_UG;
+	tim->SR = 0;
+
+	tim->CR1 |= (one_pulse ? (TIM_CR1_OPM | TIM_CR1_CEN) : TIM_CR1_CEN);
+}
+
+/********************** end of file ******************************************/
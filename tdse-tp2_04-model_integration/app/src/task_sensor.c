@@ -40,15 +40,21 @@
 #include "main.h"
 
 /* Demo includes */
+#define LOGGER_MODULE			LOGGER_MODULE_TASK_SENSOR
 #include "logger.h"
 #include "dwt.h"
+#include "bitmap.h"
+#include "trace.h"
+#include "latency.h"
+#include "e2e_latency.h"
 
 /* Application & Tasks includes */
 #include "board.h"
 #include "app.h"
-#include "task_sensor_attribute.h"
 #include "task_system_attribute.h"
 #include "task_system_interface.h"
+#include "task_sensor_attribute.h"
+#include "task_sensor.h"
 
 /********************** macros and definitions *******************************/
 #define G_TASK_SEN_CNT_INIT			0ul
@@ -58,22 +64,62 @@
 #define DEL_BTN_XX_MED				25ul
 #define DEL_BTN_XX_MAX				50ul
 
+#define DEL_GES_XX_NONE				0ul
+#define DEL_GES_XX_CHORD			150ul
+#define DEL_GES_XX_DOUBLE			300ul
+#define DEL_GES_XX_LONG				2000ul
+
 /********************** internal data declaration ****************************/
+#if (1 == TASK_SENSOR_CONFIG_BOARD)
+#if (1 == TASK_SENSOR_CONFIG_TUNABLE)
+task_sensor_cfg_t task_sensor_cfg_list[] = {
+#else
 const task_sensor_cfg_t task_sensor_cfg_list[] = {
+#endif
 	{ID_BTN_A,  BTN_A_PORT,  BTN_A_PIN,  BTN_A_PRESSED, DEL_BTN_XX_MAX,
-	 EV_SYS_IDLE,  EV_SYS_LOOP_DET}
+	 EV_SYS_IDLE,  EV_SYS_LOOP_DET,
+	 DEL_GES_XX_LONG, DEL_GES_XX_DOUBLE, DEL_GES_XX_CHORD, ID_BTN_A,
+	 EV_SYS_BTN_LONG_PRESS, EV_SYS_BTN_DOUBLE_CLICK, EV_SYS_BTN_CHORD}
 };
+#endif
 
 #define SENSOR_CFG_QTY	(sizeof(task_sensor_cfg_list)/sizeof(task_sensor_cfg_t))
 
-task_sensor_dta_t task_sensor_dta_list[] = {
-	{DEL_BTN_XX_MIN, ST_BTN_XX_UP, EV_BTN_XX_UP}
-};
+#if (1 == TASK_SENSOR_CONFIG_SOA)
+uint32_t task_sensor_dta_tick[SENSOR_CFG_QTY];
+uint8_t task_sensor_dta_state[SENSOR_CFG_QTY];
+uint8_t task_sensor_dta_event[SENSOR_CFG_QTY];
+#else
+task_sensor_dta_t task_sensor_dta_list[SENSOR_CFG_QTY];	/* task_sensor_init() */
+#endif
+
+#define SENSOR_DTA_QTY	(SENSOR_CFG_QTY)
+
+#if (1 == TRACE_CONFIG_ENABLE)
+/* Trace records carry the table index in 8 bits (TRACE_STATE()) */
+_Static_assert(SENSOR_DTA_QTY <= TRACE_INSTANCE_QTY_MAX, "TRACE_INSTANCE_QTY_MAX below the sensor qty");
+#endif
 
-#define SENSOR_DTA_QTY	(sizeof(task_sensor_dta_list)/sizeof(task_sensor_dta_t))
+/* Active sensors: debouncing, or woken up by an EXTI edge; the others are skipped */
+uint32_t task_sensor_dta_active[BITMAP_WORDS(SENSOR_DTA_QTY)];
+
+/* Gesture data & armed timer list, only touched on edges and timer expiries */
+task_sensor_gesture_dta_t task_sensor_gesture_dta_list[SENSOR_DTA_QTY];
+
+struct
+{
+	uint32_t	count;
+	uint32_t	timer_min;
+	uint16_t	index[SENSOR_DTA_QTY];	/* 16-bit: any table the RAM can hold */
+} task_sensor_gesture_armed;
 
 /********************** internal functions declaration ***********************/
 void task_sensor_statechart(void);
+void task_sensor_gesture_statechart(uint32_t index, task_sensor_gesture_ev_t event);
+bool task_sensor_gesture_chord(uint32_t index);
+void task_sensor_gesture_timer_arm(uint32_t index, uint32_t tick);
+void task_sensor_gesture_timer_disarm(uint32_t index);
+void task_sensor_gesture_timer_update(void);
 
 /********************** internal data definition *****************************/
 const char *p_task_sensor 		= "Task Sensor (Sensor Statechart)";
@@ -87,7 +133,6 @@ volatile uint32_t g_task_sensor_tick_cnt;
 void task_sensor_init(void *parameters)
 {
 	uint32_t index;
-	task_sensor_dta_t *p_task_sensor_dta;
 	task_sensor_st_t state;
 	task_sensor_ev_t event;
 
@@ -102,22 +147,30 @@ void task_sensor_init(void *parameters)
 
 	for (index = 0; SENSOR_DTA_QTY > index; index++)
 	{
-		/* Update Task Sensor Data Pointer */
-		p_task_sensor_dta = &task_sensor_dta_list[index];
-
 		/* Init & Print out: Index & Task execution FSM */
+		TASK_SENSOR_DTA_TICK(index) = DEL_BTN_XX_MIN;
+
 		state = ST_BTN_XX_UP;
-		p_task_sensor_dta->state = state;
+		TASK_SENSOR_DTA_STATE(index) = state;
 
 		event = EV_BTN_XX_UP;
-		p_task_sensor_dta->event = event;
+		TASK_SENSOR_DTA_EVENT(index) = event;
 
 		LOGGER_INFO(" ");
 		LOGGER_INFO("   %s = %lu   %s = %lu   %s = %lu",
 				    GET_NAME(index), index,
 					GET_NAME(state), (uint32_t)state,
 					GET_NAME(event), (uint32_t)event);
+
+		/* Init Task Sensor Gesture FSM */
+		task_sensor_gesture_dta_list[index].state = ST_GES_XX_IDLE;
+		task_sensor_gesture_dta_list[index].armed = false;
+
+		/* Read every input once */
+		bitmap_set(task_sensor_dta_active, index);
 	}
+
+	task_sensor_gesture_armed.count = 0;
 }
 
 void task_sensor_update(void *parameters)
@@ -158,66 +211,418 @@ void task_sensor_update(void *parameters)
     }
 }
 
+void task_sensor_wakeup(uint16_t pin)
+{
+	uint32_t index;
+
+	for (index = 0; SENSOR_DTA_QTY > index; index++)
+	{
+		if (pin == task_sensor_cfg_list[index].pin)
+		{
+			bitmap_set(task_sensor_dta_active, index);
+			E2E_SENSOR_ARM(index);
+		}
+	}
+}
+
+uint32_t task_sensor_dump(uint32_t first, uint32_t qty)
+{
+	uint32_t index;
+
+	if (0 == first)
+	{
+		LOGGER_INFO("sensor: %lu, %lu gesture timers armed", (uint32_t)SENSOR_DTA_QTY,
+					task_sensor_gesture_armed.count);
+	}
+
+	for (index = first; (SENSOR_DTA_QTY > index) && ((first + qty) > index); index++)
+	{
+		LOGGER_INFO(" %lu state %lu tick %lu tick_max %lu gesture %lu timer %lu active %lu", index,
+					(uint32_t)TASK_SENSOR_DTA_STATE(index), TASK_SENSOR_DTA_TICK(index),
+					task_sensor_cfg_list[index].tick_max, (uint32_t)task_sensor_gesture_dta_list[index].state,
+					(true == task_sensor_gesture_dta_list[index].armed) ?
+						(task_sensor_gesture_dta_list[index].timer - g_task_sensor_cnt) : 0ul,
+					(uint32_t)bitmap_get(task_sensor_dta_active, index));
+	}
+
+	return index;
+}
+
+bool task_sensor_tick_max_set(uint32_t index, uint32_t tick_max)
+{
+#if (1 == TASK_SENSOR_CONFIG_TUNABLE)
+	if (SENSOR_CFG_QTY > index)
+	{
+		/* Next debounce, task context as the statechart */
+		task_sensor_cfg_list[index].tick_max = tick_max;
+		return true;
+	}
+#endif
+	return false;
+}
+
 void task_sensor_statechart(void)
 {
 	uint32_t index;
 	const task_sensor_cfg_t *p_task_sensor_cfg;
-	task_sensor_dta_t *p_task_sensor_dta;
+	uint32_t state;
 
-	for (index = 0; SENSOR_DTA_QTY > index; index++)
+	for (index = bitmap_next(task_sensor_dta_active, SENSOR_DTA_QTY, 0);
+		 SENSOR_DTA_QTY > index;
+		 index = bitmap_next(task_sensor_dta_active, SENSOR_DTA_QTY, index + 1))
 	{
-		/* Update Task Sensor Configuration & Data Pointer */
+		/* Update Task Sensor Configuration Pointer */
 		p_task_sensor_cfg = &task_sensor_cfg_list[index];
-		p_task_sensor_dta = &task_sensor_dta_list[index];
+
+		/* Stable state: idle until the next edge, cleared before the read so no edge is lost */
+		if ((ST_BTN_XX_UP == TASK_SENSOR_DTA_STATE(index)) || (ST_BTN_XX_DOWN == TASK_SENSOR_DTA_STATE(index)))
+		{
+			__asm("CPSID i");	/* disable interrupts */
+			bitmap_clr(task_sensor_dta_active, index);
+			__asm("CPSIE i");	/* enable interrupts */
+		}
 
 		if (p_task_sensor_cfg->pressed == HAL_GPIO_ReadPin(p_task_sensor_cfg->gpio_port, p_task_sensor_cfg->pin))
 		{
-			p_task_sensor_dta->event =	EV_BTN_XX_DOWN;
+			TASK_SENSOR_DTA_EVENT(index) =	EV_BTN_XX_DOWN;
 		}
 		else
 		{
-			p_task_sensor_dta->event =	EV_BTN_XX_UP;
+			TASK_SENSOR_DTA_EVENT(index) =	EV_BTN_XX_UP;
 		}
 
-		switch (p_task_sensor_dta->state)
+		state = TASK_SENSOR_DTA_STATE(index);
+
+		switch (TASK_SENSOR_DTA_STATE(index))
 		{
 			case ST_BTN_XX_UP:
 
-				if (EV_BTN_XX_DOWN == p_task_sensor_dta->event)
+				if (EV_BTN_XX_DOWN == TASK_SENSOR_DTA_EVENT(index))
 				{
-					put_event_task_system(p_task_sensor_cfg->signal_down);
-					p_task_sensor_dta->state = ST_BTN_XX_DOWN;
+					TASK_SENSOR_DTA_TICK(index) = p_task_sensor_cfg->tick_max;
+					TASK_SENSOR_DTA_STATE(index) = ST_BTN_XX_FALLING;
+					E2E_SENSOR_ARM(index);
 				}
 
 				break;
 
 			case ST_BTN_XX_FALLING:
 
+				if (DEL_BTN_XX_MIN < TASK_SENSOR_DTA_TICK(index))
+				{
+					TASK_SENSOR_DTA_TICK(index)--;
+				}
+				else if (EV_BTN_XX_DOWN == TASK_SENSOR_DTA_EVENT(index))
+				{
+					E2E_SENSOR_EMIT(index);
+					put_event_task_system(p_task_sensor_cfg->signal_down);
+					task_sensor_gesture_statechart(index, EV_GES_XX_DOWN);
+					TASK_SENSOR_DTA_STATE(index) = ST_BTN_XX_DOWN;
+				}
+				else
+				{
+					TASK_SENSOR_DTA_STATE(index) = ST_BTN_XX_UP;
+				}
+
 				break;
 
 			case ST_BTN_XX_DOWN:
 
-				if (EV_BTN_XX_UP == p_task_sensor_dta->event)
+				if (EV_BTN_XX_UP == TASK_SENSOR_DTA_EVENT(index))
 				{
-					put_event_task_system(p_task_sensor_cfg->signal_up);
-					p_task_sensor_dta->state = ST_BTN_XX_UP;
+					TASK_SENSOR_DTA_TICK(index) = p_task_sensor_cfg->tick_max;
+					TASK_SENSOR_DTA_STATE(index) = ST_BTN_XX_RISING;
+					E2E_SENSOR_ARM(index);
 				}
 
 				break;
 
 			case ST_BTN_XX_RISING:
 
+				if (DEL_BTN_XX_MIN < TASK_SENSOR_DTA_TICK(index))
+				{
+					TASK_SENSOR_DTA_TICK(index)--;
+				}
+				else if (EV_BTN_XX_UP == TASK_SENSOR_DTA_EVENT(index))
+				{
+					E2E_SENSOR_EMIT(index);
+					put_event_task_system(p_task_sensor_cfg->signal_up);
+					task_sensor_gesture_statechart(index, EV_GES_XX_UP);
+					TASK_SENSOR_DTA_STATE(index) = ST_BTN_XX_UP;
+				}
+				else
+				{
+					TASK_SENSOR_DTA_STATE(index) = ST_BTN_XX_DOWN;
+				}
+
 				break;
 
 			default:
 
-				p_task_sensor_dta->tick  = DEL_BTN_XX_MIN;
-				p_task_sensor_dta->state = ST_BTN_XX_UP;
-				p_task_sensor_dta->event = EV_BTN_XX_UP;
+				TASK_SENSOR_DTA_TICK(index)  = DEL_BTN_XX_MIN;
+				TASK_SENSOR_DTA_STATE(index) = ST_BTN_XX_UP;
+				TASK_SENSOR_DTA_EVENT(index) = EV_BTN_XX_UP;
 
 				break;
 		}
+
+		TRACE_STATE(TRACE_FSM_SENSOR, index, state, TASK_SENSOR_DTA_STATE(index));
+
+		/* Debouncing: keep it active */
+		if ((ST_BTN_XX_FALLING == TASK_SENSOR_DTA_STATE(index)) || (ST_BTN_XX_RISING == TASK_SENSOR_DTA_STATE(index)))
+		{
+			__asm("CPSID i");	/* disable interrupts */
+			bitmap_set(task_sensor_dta_active, index);
+			__asm("CPSIE i");	/* enable interrupts */
+		}
+		else
+		{
+			/* Settled: an edge that did not make it through the debounce is no stimulus */
+			E2E_SENSOR_DISARM(index);
+		}
+	}
+
+	/* Only armed gesture timers are checked, idle sensors cost nothing here */
+	task_sensor_gesture_timer_update();
+}
+
+void task_sensor_gesture_statechart(uint32_t index, task_sensor_gesture_ev_t event)
+{
+	const task_sensor_cfg_t *p_task_sensor_cfg;
+	task_sensor_gesture_dta_t *p_task_sensor_gesture_dta;
+	uint32_t state;
+
+	/* Update Task Sensor Configuration & Gesture Data Pointer */
+	p_task_sensor_cfg = &task_sensor_cfg_list[index];
+	p_task_sensor_gesture_dta = &task_sensor_gesture_dta_list[index];
+
+	if (EV_GES_XX_DOWN == event)
+	{
+		p_task_sensor_gesture_dta->tick_down = g_task_sensor_cnt;
+	}
+
+	state = p_task_sensor_gesture_dta->state;
+
+	switch (p_task_sensor_gesture_dta->state)
+	{
+		case ST_GES_XX_IDLE:
+
+			if (EV_GES_XX_DOWN == event)
+			{
+				if (true == task_sensor_gesture_chord(index))
+				{
+					put_event_task_system(p_task_sensor_cfg->signal_chord);
+					p_task_sensor_gesture_dta->state = ST_GES_XX_HOLD;
+				}
+				else
+				{
+					task_sensor_gesture_timer_arm(index, p_task_sensor_cfg->tick_long);
+					p_task_sensor_gesture_dta->state = ST_GES_XX_PRESSED;
+				}
+			}
+
+			break;
+
+		case ST_GES_XX_PRESSED:
+
+			if (EV_GES_XX_UP == event)
+			{
+				task_sensor_gesture_timer_arm(index, p_task_sensor_cfg->tick_double);
+
+				if (DEL_GES_XX_NONE < p_task_sensor_cfg->tick_double)
+				{
+					p_task_sensor_gesture_dta->state = ST_GES_XX_RELEASED;
+				}
+				else
+				{
+					p_task_sensor_gesture_dta->state = ST_GES_XX_IDLE;
+				}
+			}
+			else if (EV_GES_XX_TIMEOUT == event)
+			{
+				put_event_task_system(p_task_sensor_cfg->signal_long);
+				p_task_sensor_gesture_dta->state = ST_GES_XX_HOLD;
+			}
+
+			break;
+
+		case ST_GES_XX_RELEASED:
+
+			if (EV_GES_XX_DOWN == event)
+			{
+				task_sensor_gesture_timer_disarm(index);
+
+				if (true == task_sensor_gesture_chord(index))
+				{
+					put_event_task_system(p_task_sensor_cfg->signal_chord);
+				}
+				else
+				{
+					put_event_task_system(p_task_sensor_cfg->signal_double);
+				}
+				p_task_sensor_gesture_dta->state = ST_GES_XX_HOLD;
+			}
+			else if (EV_GES_XX_TIMEOUT == event)
+			{
+				p_task_sensor_gesture_dta->state = ST_GES_XX_IDLE;
+			}
+
+			break;
+
+		case ST_GES_XX_HOLD:
+
+			if (EV_GES_XX_UP == event)
+			{
+				p_task_sensor_gesture_dta->state = ST_GES_XX_IDLE;
+			}
+
+			break;
+
+		default:
+
+			task_sensor_gesture_timer_disarm(index);
+			p_task_sensor_gesture_dta->state = ST_GES_XX_IDLE;
+
+			break;
+	}
+
+	TRACE_STATE(TRACE_FSM_GESTURE, index, state, p_task_sensor_gesture_dta->state);
+}
+
+bool task_sensor_gesture_chord(uint32_t index)
+{
+	const task_sensor_cfg_t *p_task_sensor_cfg;
+	task_sensor_gesture_dta_t *p_partner_gesture_dta;
+	uint32_t partner;
+
+	p_task_sensor_cfg = &task_sensor_cfg_list[index];
+	partner = (uint32_t)p_task_sensor_cfg->chord_with;
+
+	if ((DEL_GES_XX_NONE == p_task_sensor_cfg->tick_chord) || (index == partner))
+	{
+		return false;
+	}
+
+	/* Partner must be down (debounced) and pressed inside the chord window */
+	p_partner_gesture_dta = &task_sensor_gesture_dta_list[partner];
+
+	if ((ST_BTN_XX_DOWN != TASK_SENSOR_DTA_STATE(partner)) &&
+		(ST_BTN_XX_RISING != TASK_SENSOR_DTA_STATE(partner)))
+	{
+		return false;
+	}
+
+	if ((g_task_sensor_cnt - p_partner_gesture_dta->tick_down) > p_task_sensor_cfg->tick_chord)
+	{
+		return false;
+	}
+
+	/* The chord consumes the partner press: no long press nor double click from it */
+	task_sensor_gesture_timer_disarm(partner);
+	TRACE_STATE(TRACE_FSM_GESTURE, partner, p_partner_gesture_dta->state, ST_GES_XX_HOLD);
+	p_partner_gesture_dta->state = ST_GES_XX_HOLD;
+
+	return true;
+}
+
+void task_sensor_gesture_timer_arm(uint32_t index, uint32_t tick)
+{
+	task_sensor_gesture_dta_t *p_task_sensor_gesture_dta;
+
+	if (DEL_GES_XX_NONE == tick)
+	{
+		task_sensor_gesture_timer_disarm(index);
+		return;
+	}
+
+	p_task_sensor_gesture_dta = &task_sensor_gesture_dta_list[index];
+	p_task_sensor_gesture_dta->timer = g_task_sensor_cnt + tick;
+
+	if (false == p_task_sensor_gesture_dta->armed)
+	{
+		p_task_sensor_gesture_dta->armed = true;
+		task_sensor_gesture_armed.index[task_sensor_gesture_armed.count++] = (uint16_t)index;
+	}
+
+	/* Keep the nearest expiry, so the per tick check is a single compare */
+	if ((1 == task_sensor_gesture_armed.count) ||
+		((int32_t)(p_task_sensor_gesture_dta->timer - task_sensor_gesture_armed.timer_min) < 0))
+	{
+		task_sensor_gesture_armed.timer_min = p_task_sensor_gesture_dta->timer;
+	}
+}
+
+void task_sensor_gesture_timer_disarm(uint32_t index)
+{
+	uint32_t i;
+
+	if (false == task_sensor_gesture_dta_list[index].armed)
+	{
+		return;
+	}
+
+	task_sensor_gesture_dta_list[index].armed = false;
+
+	for (i = 0; task_sensor_gesture_armed.count > i; i++)
+	{
+		if (index == task_sensor_gesture_armed.index[i])
+		{
+			task_sensor_gesture_armed.count--;
+			task_sensor_gesture_armed.index[i] = task_sensor_gesture_armed.index[task_sensor_gesture_armed.count];
+			break;
+		}
+	}
+
+	/* timer_min may be early now, the next update finds nothing expired and refreshes it */
+}
+
+void task_sensor_gesture_timer_update(void)
+{
+	uint32_t i;
+	uint32_t index;
+	uint32_t timer_min;
+	task_sensor_gesture_dta_t *p_task_sensor_gesture_dta;
+
+	if ((0 == task_sensor_gesture_armed.count) ||
+		((int32_t)(g_task_sensor_cnt - task_sensor_gesture_armed.timer_min) < 0))
+	{
+		return;
+	}
+
+	/* Fire expired timers, then recompute the nearest expiry of the remaining ones */
+	i = 0;
+	while (task_sensor_gesture_armed.count > i)
+	{
+		index = task_sensor_gesture_armed.index[i];
+		p_task_sensor_gesture_dta = &task_sensor_gesture_dta_list[index];
+
+		if ((int32_t)(g_task_sensor_cnt - p_task_sensor_gesture_dta->timer) >= 0)
+		{
+			p_task_sensor_gesture_dta->armed = false;
+			task_sensor_gesture_armed.count--;
+			task_sensor_gesture_armed.index[i] = task_sensor_gesture_armed.index[task_sensor_gesture_armed.count];
+
+			/* A timeout never re-arms a timer, so the armed list only shrinks here */
+			E2E_ORIGIN_NOW();
+			task_sensor_gesture_statechart(index, EV_GES_XX_TIMEOUT);
+		}
+		else
+		{
+			i++;
+		}
+	}
+
+	timer_min = g_task_sensor_cnt;
+	for (i = 0; task_sensor_gesture_armed.count > i; i++)
+	{
+		p_task_sensor_gesture_dta = &task_sensor_gesture_dta_list[task_sensor_gesture_armed.index[i]];
+
+		if ((0 == i) || ((int32_t)(p_task_sensor_gesture_dta->timer - timer_min) < 0))
+		{
+			timer_min = p_task_sensor_gesture_dta->timer;
+		}
 	}
+	task_sensor_gesture_armed.timer_min = timer_min;
 }
 
 /********************** end of file ******************************************/
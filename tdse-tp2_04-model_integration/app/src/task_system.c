@@ -40,8 +40,11 @@
 #include "main.h"
 
 /* Demo includes */
+#define LOGGER_MODULE			LOGGER_MODULE_TASK_SYSTEM
+#define LOGGER_MODULE_LEVEL		LOGGER_LEVEL_TRACE	/* traces compiled in, enabled at runtime */
 #include "logger.h"
 #include "dwt.h"
+#include "trace.h"
 
 /* Application & Tasks includes */
 #include "board.h"
@@ -153,17 +156,30 @@ void task_system_update(void *parameters)
     }
 }
 
+void task_system_dump(void)
+{
+	LOGGER_INFO("system: state %lu event %lu flag %lu tick %lu queue %lu max %lu",
+				(uint32_t)task_system_dta.state, (uint32_t)task_system_dta.event,
+				(uint32_t)task_system_dta.flag, task_system_dta.tick,
+				count_event_task_system(), count_max_event_task_system());
+}
+
 void task_system_statechart(void)
 {
 	task_system_dta_t *p_task_system_dta;
+	uint32_t state;
 
 	/* Update Task System Data Pointer */
 	p_task_system_dta = &task_system_dta;
+	state = p_task_system_dta->state;
 
 	if (true == any_event_task_system())
 	{
 		p_task_system_dta->flag = true;
 		p_task_system_dta->event = get_event_task_system();
+		LOGGER_TRACE("%s: %s = %lu in %s = %lu", GET_NAME(task_system),
+					 GET_NAME(event), (uint32_t)p_task_system_dta->event,
+					 GET_NAME(state), (uint32_t)p_task_system_dta->state);
 	}
 
 	switch (p_task_system_dta->state)
@@ -175,6 +191,7 @@ void task_system_statechart(void)
 				p_task_system_dta->flag = false;
 				put_event_task_actuator(EV_LED_XX_ON, ID_LED_A);
 				p_task_system_dta->state = ST_SYS_ACTIVE_01;
+				LOGGER_DEBUG("%s: %s -> %s", GET_NAME(task_system), GET_NAME(ST_SYS_IDLE), GET_NAME(ST_SYS_ACTIVE_01));
 			}
 
 			break;
@@ -186,6 +203,7 @@ void task_system_statechart(void)
 				p_task_system_dta->flag = false;
 				put_event_task_actuator(EV_LED_XX_OFF, ID_LED_A);
 				p_task_system_dta->state = ST_SYS_IDLE;
+				LOGGER_DEBUG("%s: %s -> %s", GET_NAME(task_system), GET_NAME(ST_SYS_ACTIVE_01), GET_NAME(ST_SYS_IDLE));
 			}
 
 			break;
@@ -219,6 +237,8 @@ void task_system_statechart(void)
 
 			break;
 	}
+
+	TRACE_STATE(TRACE_FSM_SYSTEM, 0, state, p_task_system_dta->state);
 }
 
 /********************** end of file ******************************************/
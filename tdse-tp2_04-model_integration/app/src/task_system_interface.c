@@ -41,8 +41,12 @@
 #include "main.h"
 
 /* Demo includes */
+#define LOGGER_MODULE			LOGGER_MODULE_TASK_SYSTEM
 #include "logger.h"
 #include "dwt.h"
+#include "trace.h"
+#include "latency.h"
+#include "e2e_latency.h"
 
 /* Application & Tasks includes */
 #include "board.h"
@@ -63,7 +67,11 @@ struct
 	uint32_t	head;
 	uint32_t	tail;
 	uint32_t	count;
+	uint32_t	count_max;
 	task_system_ev_t	queue[MAX_EVENTS];
+#if 1 == E2E_CONFIG_ENABLE
+	e2e_stamp_t	stamp[MAX_EVENTS];	/* origin of each queued event */
+#endif
 } queue_task_a;
 
 /********************** external data declaration ****************************/
@@ -76,6 +84,7 @@ void init_queue_event_task_system(void)
 	queue_task_a.head = 0;
 	queue_task_a.tail = 0;
 	queue_task_a.count = 0;
+	queue_task_a.count_max = 0;
 
 	for (i = 0; i < MAX_EVENTS; i++)
 		queue_task_a.queue[i] = EVENT_UNDEFINED;
@@ -84,10 +93,15 @@ void init_queue_event_task_system(void)
 void put_event_task_system(task_system_ev_t event)
 {
 	queue_task_a.count++;
+	if (queue_task_a.count_max < queue_task_a.count)
+		queue_task_a.count_max = queue_task_a.count;
+	E2E_PUT(&queue_task_a.stamp[queue_task_a.head], event);
 	queue_task_a.queue[queue_task_a.head++] = event;
 
 	if (MAX_EVENTS == queue_task_a.head)
 		queue_task_a.head = 0;
+
+	TRACE_EVENT_PUT(TRACE_QUEUE_SYSTEM, event);
 }
 
 task_system_ev_t get_event_task_system(void)
@@ -96,11 +110,14 @@ task_system_ev_t get_event_task_system(void)
 
 	queue_task_a.count--;
 	event = queue_task_a.queue[queue_task_a.tail];
+	E2E_GET(&queue_task_a.stamp[queue_task_a.tail]);
 	queue_task_a.queue[queue_task_a.tail++] = EVENT_UNDEFINED;
 
 	if (MAX_EVENTS == queue_task_a.tail)
 		queue_task_a.tail = 0;
 
+	TRACE_EVENT_GET(TRACE_QUEUE_SYSTEM, event);
+
 	return event;
 }
 
@@ -109,4 +126,19 @@ bool any_event_task_system(void)
   return (queue_task_a.head != queue_task_a.tail);
 }
 
+uint32_t count_event_task_system(void)
+{
+  return queue_task_a.count;
+}
+
+uint32_t count_max_event_task_system(void)
+{
+  return queue_task_a.count_max;
+}
+
+void clear_count_max_event_task_system(void)
+{
+  queue_task_a.count_max = queue_task_a.count;
+}
+
 /********************** end of file ******************************************/
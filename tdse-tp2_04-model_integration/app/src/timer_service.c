@@ -0,0 +1,348 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : timer_service.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+/********************** inclusions *******************************************/
+/* Standard C includes */
+#include <stdbool.h>
+#include <string.h>
+
+/* Project includes */
+#include "main.h"
+
+/* Demo includes */
+#include "dwt.h"
+#include "timer_service.h"
+
+/* Application & Tasks includes */
+#include "board.h"
+#include "app.h"
+#include "task_actuator_attribute.h"
+#include "task_actuator_tim.h"
+
+/********************** macros and definitions *******************************/
+#define TIMER_SERVICE_CNT_RANGE		(0x10000ul)	/* 16-bit counter */
+
+/* Signed distance to a deadline (wrapping 32-bit uS) */
+#define TIMER_SERVICE_DUE(deadline, now)	(0 >= (int32_t)((deadline) - (now)))
+
+/********************** internal data declaration ****************************/
+typedef struct
+{
+	timer_service_cb_t	callback;
+	void				*p_arg;
+	uint32_t			deadline;
+	uint32_t			period;
+	uint8_t				next;
+	bool				used;
+} timer_service_dta_t;
+
+/********************** internal functions declaration ***********************/
+static uint32_t timer_service_now_(void);
+static void timer_service_insert_(uint32_t id);
+static void timer_service_remove_(uint32_t id);
+static void timer_service_arm_(void);
+
+/********************** internal data definition *****************************/
+static timer_service_dta_t timer_service_dta_list_[TIMER_SERVICE_QTY];
+
+/* Pending list sorted by deadline, upper 16 bits of the uS count */
+static uint8_t timer_service_head_;
+static uint32_t timer_service_pending_;
+static volatile uint32_t timer_service_hi_;
+
+/********************** external data declaration ****************************/
+timer_service_stats_t timer_service_stats;
+
+/********************** internal functions definition ************************/
+/* Counter & its extension as one pair: update pending (counter wrapped, ISR not
+ * run yet) => one more range, the counter is read again after the wrap */
+static uint32_t timer_service_now_(void)
+{
+	TIM_TypeDef *tim = TIMER_SERVICE_TIM;
+	uint32_t hi;
+	uint32_t cnt;
+	uint32_t wrap;
+
+	do
+	{
+		hi = timer_service_hi_;
+		cnt = tim->CNT;
+		wrap = (0 != (tim->SR & TIM_SR_UIF)) ? TIMER_SERVICE_CNT_RANGE : 0;
+		if (0 != wrap)
+		{
+			cnt = tim->CNT;
+		}
+	} while (hi != timer_service_hi_);
+
+	return (hi + wrap) | cnt;
+}
+
+/* Interrupts masked or TIM2 ISR: after the timers with the same or an earlier deadline */
+static void timer_service_insert_(uint32_t id)
+{
+	timer_service_dta_t *p_dta = &timer_service_dta_list_[id];
+	uint8_t *p_link = &timer_service_head_;
+
+	while ((TIMER_SERVICE_NONE != *p_link) &&
+		   (0 <= (int32_t)(p_dta->deadline - timer_service_dta_list_[*p_link].deadline)))
+	{
+		p_link = &timer_service_dta_list_[*p_link].next;
+	}
+
+	p_dta->next = *p_link;
+	*p_link = (uint8_t)id;
+
+	timer_service_pending_++;
+	if (timer_service_stats.pending_max < timer_service_pending_)
+	{
+		timer_service_stats.pending_max = timer_service_pending_;
+	}
+}
+
+static void timer_service_remove_(uint32_t id)
+{
+	uint8_t *p_link = &timer_service_head_;
+
+	while (TIMER_SERVICE_NONE != *p_link)
+	{
+		if (id == *p_link)
+		{
+			*p_link = timer_service_dta_list_[id].next;
+			timer_service_pending_--;
+			return;
+		}
+		p_link = &timer_service_dta_list_[*p_link].next;
+	}
+}
+
+/* Channel 1 compare on the earliest deadline within the counter range, else the
+ * update interrupt comes first and arms it again; already due => forced compare */
+static void timer_service_arm_(void)
+{
+	TIM_TypeDef *tim = TIMER_SERVICE_TIM;
+	uint32_t deadline;
+	uint32_t now;
+
+	tim->DIER &= ~TIM_DIER_CC1IE;
+	if (TIMER_SERVICE_NONE == timer_service_head_)
+	{
+		return;
+	}
+
+	deadline = timer_service_dta_list_[timer_service_head_].deadline;
+	now = timer_service_now_();
+	if ((false == TIMER_SERVICE_DUE(deadline, now)) && (TIMER_SERVICE_CNT_RANGE <= (deadline - now)))
+	{
+		return;
+	}
+
+	/* Stale match flag of a previous compare value */
+	tim->CCR1 = deadline & (TIMER_SERVICE_CNT_RANGE - 1);
+	tim->SR = ~(uint32_t)TIM_SR_CC1IF;
+	tim->DIER |= TIM_DIER_CC1IE;
+
+	/* Counter already past the compare value */
+	if (TIMER_SERVICE_DUE(deadline, timer_service_now_()))
+	{
+		tim->EGR = TIM_EGR_CC1G;
+	}
+}
+
+/********************** external functions definition ************************/
+void timer_service_init(void)
+{
+	TIM_TypeDef *tim = TIMER_SERVICE_TIM;
+	uint32_t id;
+
+	for (id = 0; TIMER_SERVICE_QTY > id; id++)
+	{
+		timer_service_dta_list_[id].used = false;
+		timer_service_dta_list_[id].next = TIMER_SERVICE_NONE;
+	}
+	timer_service_head_ = TIMER_SERVICE_NONE;
+	timer_service_pending_ = 0;
+	timer_service_hi_ = 0;
+	memset(&timer_service_stats, 0, sizeof(timer_service_stats));
+
+	__HAL_RCC_TIM2_CLK_ENABLE();
+
+	/* Free running 1 MHz counter, full 16-bit range, URS: UG raises no interrupt */
+	tim->CR1 = TIM_CR1_URS;
+	tim->PSC = (task_actuator_tim_clk(tim) / TIMER_SERVICE_CNT_HZ) - 1;
+	tim->ARR = TIMER_SERVICE_CNT_RANGE - 1;
+	tim->CCMR1 = 0;		/* channel 1: output compare, frozen (no pin) */
+	tim->EGR = TIM_EGR_UG;
+	tim->SR = 0;
+	tim->DIER = TIM_DIER_UIE;
+
+	HAL_NVIC_SetPriority(TIMER_SERVICE_IRQn, TIMER_SERVICE_IRQ_PRIO, 0);
+	HAL_NVIC_EnableIRQ(TIMER_SERVICE_IRQn);
+
+	tim->CR1 |= TIM_CR1_CEN;
+}
+
+uint32_t timer_service_now_us(void)
+{
+	return timer_service_now_();
+}
+
+uint32_t timer_service_add(uint32_t delay_us, uint32_t period_us, timer_service_cb_t callback, void *p_arg)
+{
+	timer_service_dta_t *p_dta;
+	uint32_t id;
+
+	if ((NULL == callback) || (INT32_MAX < delay_us) || (INT32_MAX < period_us))
+	{
+		return TIMER_SERVICE_NONE;
+	}
+
+	__asm("CPSID i");	/* disable interrupts */
+	for (id = 0; TIMER_SERVICE_QTY > id; id++)
+	{
+		if (false == timer_service_dta_list_[id].used)
+		{
+			break;
+		}
+	}
+
+	if (TIMER_SERVICE_QTY > id)
+	{
+		p_dta = &timer_service_dta_list_[id];
+		p_dta->used = true;
+		p_dta->callback = callback;
+		p_dta->p_arg = p_arg;
+		p_dta->period = period_us;
+		p_dta->deadline = timer_service_now_() + delay_us;
+
+		timer_service_insert_(id);
+		if (id == timer_service_head_)
+		{
+			timer_service_arm_();
+		}
+	}
+	else
+	{
+		id = TIMER_SERVICE_NONE;
+	}
+	__asm("CPSIE i");	/* enable interrupts */
+
+	return id;
+}
+
+void timer_service_cancel(uint32_t id)
+{
+	if (TIMER_SERVICE_QTY <= id)
+	{
+		return;
+	}
+
+	__asm("CPSID i");	/* disable interrupts */
+	if (true == timer_service_dta_list_[id].used)
+	{
+		timer_service_remove_(id);
+		timer_service_dta_list_[id].used = false;
+		timer_service_arm_();
+	}
+	__asm("CPSIE i");	/* enable interrupts */
+}
+
+uint32_t timer_service_pending(void)
+{
+	return timer_service_pending_;
+}
+
+void timer_service_isr(void)
+{
+	TIM_TypeDef *tim = TIMER_SERVICE_TIM;
+	uint32_t cycles = cycle_counter_get();
+	timer_service_dta_t *p_dta;
+	uint32_t id;
+	uint32_t now;
+	uint32_t late;
+
+	/* Counter wrapped: flag & extension change together for timer_service_now_() */
+	__asm("CPSID i");	/* disable interrupts */
+	if (0 != (tim->SR & TIM_SR_UIF))
+	{
+		tim->SR = ~(uint32_t)TIM_SR_UIF;
+		timer_service_hi_ += TIMER_SERVICE_CNT_RANGE;
+	}
+	__asm("CPSIE i");	/* enable interrupts */
+	tim->SR = ~(uint32_t)TIM_SR_CC1IF;
+
+	now = timer_service_now_();
+	while ((TIMER_SERVICE_NONE != timer_service_head_) &&
+		   TIMER_SERVICE_DUE(timer_service_dta_list_[timer_service_head_].deadline, now))
+	{
+		id = timer_service_head_;
+		p_dta = &timer_service_dta_list_[id];
+		timer_service_head_ = p_dta->next;
+		timer_service_pending_--;
+
+		late = now - p_dta->deadline;
+		if (timer_service_stats.late_us_max < late)
+		{
+			timer_service_stats.late_us_max = late;
+		}
+		timer_service_stats.fired++;
+
+		/* Periodic: next deadline from the previous one (no drift), periods missed
+		 * are skipped. One-shot: free before the callback, it may add a timer */
+		if (0 != p_dta->period)
+		{
+			p_dta->deadline += p_dta->period * ((late / p_dta->period) + 1);
+			timer_service_insert_(id);
+		}
+		else
+		{
+			p_dta->used = false;
+		}
+
+		p_dta->callback(p_dta->p_arg);
+		now = timer_service_now_();
+	}
+
+	timer_service_arm_();
+
+	cycles = cycle_counter_get() - cycles;
+	if (timer_service_stats.isr_cycles_max < cycles)
+	{
+		timer_service_stats.isr_cycles_max = cycles;
+	}
+}
+
+/********************** end of file ******************************************/
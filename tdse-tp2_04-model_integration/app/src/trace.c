@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : trace.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+/********************** inclusions *******************************************/
+/* Project includes */
+#include "main.h"
+
+/* Demo includes */
+#include "dwt.h"
+#include "trace.h"
+#include "uart_dma_tx.h"
+
+/********************** macros and definitions *******************************/
+#define TRACE_DUMP_LINE_QTY		(8ul)	/* lines per trace_dump_update() call */
+#define TRACE_DUMP_LINE_LEN		(24ul)	/* "#T ssssssss tt ii aaaa\n" */
+#define TRACE_DUMP_HEAD_LEN		(40ul)	/* "#T begin nnnnnnnn cccccccc\n" */
+
+typedef enum
+{
+	TRACE_DUMP_IDLE,
+	TRACE_DUMP_BEGIN,
+	TRACE_DUMP_RECORDS,
+	TRACE_DUMP_END
+} trace_dump_t;
+
+/********************** internal data declaration ****************************/
+
+/********************** internal functions declaration ***********************/
+static uint32_t trace_put_hex_(uint32_t offset, uint32_t value, uint32_t digits);
+static uint32_t trace_put_str_(uint32_t offset, const char *p_str);
+
+/********************** internal data definition *****************************/
+static trace_dump_t trace_dump_;
+static uint32_t trace_dump_index_;		/* next record to dump, free running */
+static uint32_t trace_dump_last_;		/* one past the last record to dump */
+
+/********************** external data declaration ****************************/
+trace_record_t trace_buffer[TRACE_CONFIG_QTY];
+volatile uint32_t trace_head;
+volatile bool trace_enabled;
+
+/********************** internal functions definition ************************/
+static uint32_t trace_put_hex_(uint32_t offset, uint32_t value, uint32_t digits)
+{
+	static const char hex[] = "0123456789abcdef";
+
+	while (0 < digits)
+	{
+		digits--;
+		uart_dma_tx_put(offset++, hex[(value >> (digits * 4)) & 0xF]);
+	}
+
+	return offset;
+}
+
+static uint32_t trace_put_str_(uint32_t offset, const char *p_str)
+{
+	while ('\0' != *p_str)
+	{
+		uart_dma_tx_put(offset++, *p_str++);
+	}
+
+	return offset;
+}
+
+/********************** external functions definition ************************/
+void trace_init(void)
+{
+	trace_dump_ = TRACE_DUMP_IDLE;
+	trace_head = 0;
+	trace_enabled = true;
+}
+
+void trace_trigger(void)
+{
+	if ((TRACE_DUMP_IDLE != trace_dump_) || (false == trace_enabled))
+	{
+		return;
+	}
+
+	/* Freeze: records still being written can only belong to a preempted task,
+	 * it completes them before the idle loop dumps */
+	trace_enabled = false;
+
+	trace_dump_last_ = trace_head;
+	trace_dump_index_ = (TRACE_CONFIG_QTY < trace_dump_last_) ?
+						(trace_dump_last_ - TRACE_CONFIG_QTY) : 0;
+	trace_dump_ = TRACE_DUMP_BEGIN;
+}
+
+void trace_dump_update(void)
+{
+	const trace_record_t *p_record;
+	uint32_t offset;
+	uint32_t lines;
+
+	switch (trace_dump_)
+	{
+		case TRACE_DUMP_BEGIN:
+
+			if (TRACE_DUMP_HEAD_LEN <= uart_dma_tx_reserve())
+			{
+				offset = trace_put_str_(0, "#T begin ");
+				offset = trace_put_hex_(offset, trace_dump_last_ - trace_dump_index_, 8);
+				uart_dma_tx_put(offset++, ' ');
+				offset = trace_put_hex_(offset, SystemCoreClock, 8);
+				uart_dma_tx_put(offset++, '\n');
+				uart_dma_tx_commit(offset);
+
+				trace_dump_ = TRACE_DUMP_RECORDS;
+			}
+
+			break;
+
+		case TRACE_DUMP_RECORDS:
+
+			/* Bounded: a few lines per idle pass, only as many as fit whole */
+			for (lines = 0; TRACE_DUMP_LINE_QTY > lines; lines++)
+			{
+				if ((trace_dump_last_ == trace_dump_index_)
+				 || (TRACE_DUMP_LINE_LEN > uart_dma_tx_reserve()))
+				{
+					break;
+				}
+
+				p_record = &trace_buffer[trace_dump_index_ & (TRACE_CONFIG_QTY - 1)];
+				offset = trace_put_str_(0, "#T ");
+				offset = trace_put_hex_(offset, p_record->stamp, 8);
+				uart_dma_tx_put(offset++, ' ');
+				offset = trace_put_hex_(offset, p_record->type, 2);
+				uart_dma_tx_put(offset++, ' ');
+				offset = trace_put_hex_(offset, p_record->id, 2);
+				uart_dma_tx_put(offset++, ' ');
+				offset = trace_put_hex_(offset, p_record->arg, 4);
+				uart_dma_tx_put(offset++, '\n');
+				uart_dma_tx_commit(offset);
+
+				trace_dump_index_++;
+			}
+
+			if (trace_dump_last_ == trace_dump_index_)
+			{
+				trace_dump_ = TRACE_DUMP_END;
+			}
+
+			break;
+
+		case TRACE_DUMP_END:
+
+			if (TRACE_DUMP_LINE_LEN <= uart_dma_tx_reserve())
+			{
+				uart_dma_tx_commit(trace_put_str_(0, "#T end\n"));
+
+				/* Record again, from an empty ring */
+				trace_init();
+			}
+
+			break;
+
+		case TRACE_DUMP_IDLE:
+		default:
+
+			break;
+	}
+}
+
+/********************** end of file ******************************************/
@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : uart_dma_rx.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+/********************** inclusions *******************************************/
+/* Standard C includes */
+#include <stdbool.h>
+
+/* Project includes */
+#include "main.h"
+
+/* Demo includes */
+#include "dwt.h"
+#include "uart_dma_rx.h"
+
+/********************** macros and definitions *******************************/
+#define UART_DMA_RX_RING_MASK	(UART_DMA_RX_RING_SIZE - 1)
+
+/********************** internal data declaration ****************************/
+/* DMA producer (head, published from the interrupts), single consumer (tail),
+ * free running indexes */
+typedef struct
+{
+	volatile uint32_t	head;
+	uint32_t			tail;
+	uint32_t			position;	/* DMA write index at the last interrupt */
+	uint8_t				buffer[UART_DMA_RX_RING_SIZE];
+} uart_dma_rx_ring_t;
+
+/********************** internal functions declaration ***********************/
+
+/********************** internal data definition *****************************/
+static uart_dma_rx_ring_t uart_dma_rx_ring_;
+
+/********************** external data declaration ****************************/
+uart_dma_rx_stats_t uart_dma_rx_stats;
+
+/********************** internal functions definition ************************/
+
+/********************** external functions definition ************************/
+void uart_dma_rx_init(void)
+{
+	__HAL_RCC_DMA1_CLK_ENABLE();
+
+	/* USART2->DR => memory, byte size, memory increment, circular, half & full transfer interrupts */
+	UART_DMA_RX_CHANNEL->CCR = 0;
+	UART_DMA_RX_CHANNEL->CPAR = (uint32_t)&UART_DMA_RX_USART->DR;
+	UART_DMA_RX_CHANNEL->CMAR = (uint32_t)uart_dma_rx_ring_.buffer;
+	UART_DMA_RX_CHANNEL->CNDTR = UART_DMA_RX_RING_SIZE;
+	UART_DMA_RX_CHANNEL->CCR = DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE;
+	DMA1->IFCR = DMA_IFCR_CGIF6;
+	UART_DMA_RX_CHANNEL->CCR |= DMA_CCR_EN;
+
+	HAL_NVIC_SetPriority(UART_DMA_RX_DMA_IRQn, UART_DMA_RX_IRQ_PRIO, 0);
+	HAL_NVIC_EnableIRQ(UART_DMA_RX_DMA_IRQn);
+	HAL_NVIC_SetPriority(UART_DMA_RX_USART_IRQn, UART_DMA_RX_IRQ_PRIO, 0);
+	HAL_NVIC_EnableIRQ(UART_DMA_RX_USART_IRQn);
+
+	/* USART2 already initialized by MX_USART2_UART_Init() */
+	UART_DMA_RX_USART->CR3 |= USART_CR3_DMAR;
+	UART_DMA_RX_USART->CR1 |= USART_CR1_IDLEIE;
+}
+
+uint32_t uart_dma_rx_available(void)
+{
+	return uart_dma_rx_ring_.head - uart_dma_rx_ring_.tail;
+}
+
+uint32_t uart_dma_rx_read(char *p_data, uint32_t len)
+{
+	uint32_t head = uart_dma_rx_ring_.head;
+	uint32_t index;
+
+	/* Lapped by the DMA: what is left is a mix of old & new bytes, drop it all */
+	if (UART_DMA_RX_RING_SIZE < (head - uart_dma_rx_ring_.tail))
+	{
+		uart_dma_rx_stats.overrun += head - uart_dma_rx_ring_.tail;
+		uart_dma_rx_ring_.tail = head;
+	}
+
+	if (len > (head - uart_dma_rx_ring_.tail))
+	{
+		len = head - uart_dma_rx_ring_.tail;
+	}
+
+	for (index = 0; len > index; index++)
+	{
+		p_data[index] = (char)uart_dma_rx_ring_.buffer[(uart_dma_rx_ring_.tail + index) & UART_DMA_RX_RING_MASK];
+	}
+	uart_dma_rx_ring_.tail += len;
+
+	return len;
+}
+
+void uart_dma_rx_isr(void)
+{
+	uint32_t cycles = cycle_counter_get();
+	uint32_t flags;
+	uint32_t position;
+	uint32_t len;
+
+	/* Idle line: SR then DR read clears it, the DMA already took the last byte */
+	if (0 != (UART_DMA_RX_USART->SR & USART_SR_IDLE))
+	{
+		(void)UART_DMA_RX_USART->DR;
+		uart_dma_rx_stats.idle++;
+	}
+	flags = DMA1->ISR & (DMA_ISR_HTIF6 | DMA_ISR_TCIF6);
+	DMA1->IFCR = DMA_IFCR_CHTIF6 | DMA_IFCR_CTCIF6 | DMA_IFCR_CGIF6;
+
+	/* Bytes since the last interrupt: at most half a ring, an interrupt every half */
+	position = (UART_DMA_RX_RING_SIZE - UART_DMA_RX_CHANNEL->CNDTR) & UART_DMA_RX_RING_MASK;
+	len = (position - uart_dma_rx_ring_.position) & UART_DMA_RX_RING_MASK;
+
+	/* Late by a lap or more: the modulo lost it. Both halves were reached but
+	 * the span since the last position covers less than both, add the lap so
+	 * uart_dma_rx_read() sees the overrun (a mark reached between the clear &
+	 * the CNDTR read, a few cycles against ~87 uS a byte, is not told apart) */
+	if (((DMA_ISR_HTIF6 | DMA_ISR_TCIF6) == flags) &&
+		(2ul > (((uart_dma_rx_ring_.position + len) / (UART_DMA_RX_RING_SIZE / 2)) -
+				(uart_dma_rx_ring_.position / (UART_DMA_RX_RING_SIZE / 2)))))
+	{
+		len += UART_DMA_RX_RING_SIZE;
+	}
+	uart_dma_rx_ring_.position = position;
+
+	uart_dma_rx_ring_.head += len;
+	uart_dma_rx_stats.bytes += len;
+
+	uart_dma_rx_stats.isr_cycles += cycle_counter_get() - cycles;
+}
+
+/********************** end of file ******************************************/
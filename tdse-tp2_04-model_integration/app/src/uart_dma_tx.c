@@ -0,0 +1,238 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : uart_dma_tx.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ */
+
+/********************** inclusions *******************************************/
+/* Standard C includes */
+#include <stdbool.h>
+
+/* Project includes */
+#include "main.h"
+
+/* Demo includes */
+#include "dwt.h"
+#include "uart_dma_tx.h"
+
+/********************** macros and definitions *******************************/
+#define UART_DMA_TX_RING_MASK	(UART_DMA_TX_RING_SIZE - 1)
+
+/********************** internal data declaration ****************************/
+/* Single producer (head), DMA consumer (tail), free running indexes */
+typedef struct
+{
+	volatile uint32_t	head;
+	volatile uint32_t	tail;
+	volatile bool		busy;
+	uint32_t			chunk;		/* bytes of the DMA transfer in flight */
+	uint32_t			released;	/* bytes of it already given back (half transfer) */
+	uint32_t			tick_start;
+	uint8_t				buffer[UART_DMA_TX_RING_SIZE];
+} uart_dma_tx_ring_t;
+
+/********************** internal functions declaration ***********************/
+static void uart_dma_tx_start_(void);
+
+/********************** internal data definition *****************************/
+static uart_dma_tx_ring_t uart_dma_tx_ring_;
+
+/********************** external data declaration ****************************/
+uart_dma_tx_stats_t uart_dma_tx_stats;
+
+/********************** internal functions definition ************************/
+/* Next contiguous chunk [tail .. head or ring end], interrupts masked or DMA ISR */
+static void uart_dma_tx_start_(void)
+{
+	uint32_t tail = uart_dma_tx_ring_.tail;
+	uint32_t index = tail & UART_DMA_TX_RING_MASK;
+	uint32_t len = uart_dma_tx_ring_.head - tail;
+
+	if (0 == len)
+	{
+		uart_dma_tx_ring_.busy = false;
+		return;
+	}
+
+	if (UART_DMA_TX_RING_SIZE < (index + len))
+	{
+		len = UART_DMA_TX_RING_SIZE - index;
+	}
+
+	uart_dma_tx_ring_.chunk = len;
+	uart_dma_tx_ring_.released = 0;
+	uart_dma_tx_ring_.busy = true;
+	uart_dma_tx_stats.chunks++;
+
+	UART_DMA_TX_CHANNEL->CCR &= ~DMA_CCR_EN;
+	UART_DMA_TX_CHANNEL->CMAR = (uint32_t)&uart_dma_tx_ring_.buffer[index];
+	UART_DMA_TX_CHANNEL->CNDTR = len;
+	UART_DMA_TX_CHANNEL->CCR |= DMA_CCR_EN;
+}
+
+/********************** external functions definition ************************/
+void uart_dma_tx_init(void)
+{
+	__HAL_RCC_DMA1_CLK_ENABLE();
+
+	/* Memory => USART2->DR, byte size, memory increment, half & full transfer interrupts */
+	UART_DMA_TX_CHANNEL->CCR = 0;
+	UART_DMA_TX_CHANNEL->CPAR = (uint32_t)&UART_DMA_TX_USART->DR;
+	UART_DMA_TX_CHANNEL->CCR = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_TEIE;
+	DMA1->IFCR = DMA_IFCR_CGIF7;
+
+	HAL_NVIC_SetPriority(UART_DMA_TX_IRQn, UART_DMA_TX_IRQ_PRIO, 0);
+	HAL_NVIC_EnableIRQ(UART_DMA_TX_IRQn);
+
+	/* USART2 already initialized by MX_USART2_UART_Init() */
+	UART_DMA_TX_USART->CR3 |= USART_CR3_DMAT;
+}
+
+uint32_t uart_dma_tx_free(void)
+{
+	return UART_DMA_TX_RING_SIZE - (uart_dma_tx_ring_.head - uart_dma_tx_ring_.tail);
+}
+
+void uart_dma_tx_poll_put(char data)
+{
+	while (0 == (UART_DMA_TX_USART->SR & USART_SR_TXE))
+	{
+	}
+	UART_DMA_TX_USART->DR = (uint8_t)data;
+}
+
+uint32_t uart_dma_tx_reserve(void)
+{
+	/* The DMA ISR only frees space: the producer owns the bytes from head on */
+	return uart_dma_tx_free();
+}
+
+void uart_dma_tx_put(uint32_t offset, char data)
+{
+	uart_dma_tx_ring_.buffer[(uart_dma_tx_ring_.head + offset) & UART_DMA_TX_RING_MASK] = (uint8_t)data;
+}
+
+void uart_dma_tx_commit(uint32_t len)
+{
+	uint32_t cycles = cycle_counter_get();
+
+	if (0 == len)
+	{
+		return;
+	}
+
+	/* Bytes in the ring before the DMA can see them */
+	__DMB();
+	uart_dma_tx_ring_.head += len;
+
+	uart_dma_tx_stats.bytes_in += len;
+	if (uart_dma_tx_stats.level_max < (uart_dma_tx_ring_.head - uart_dma_tx_ring_.tail))
+	{
+		uart_dma_tx_stats.level_max = uart_dma_tx_ring_.head - uart_dma_tx_ring_.tail;
+	}
+
+	/* Idle DMA: start it, otherwise the transfer complete interrupt chains the new bytes */
+	__asm("CPSID i");	/* disable interrupts */
+	if (false == uart_dma_tx_ring_.busy)
+	{
+		uart_dma_tx_ring_.tick_start = HAL_GetTick();
+		uart_dma_tx_start_();
+	}
+	__asm("CPSIE i");	/* enable interrupts */
+
+	uart_dma_tx_stats.write_cycles += cycle_counter_get() - cycles;
+}
+
+void uart_dma_tx_abort(uint32_t len)
+{
+	uart_dma_tx_stats.dropped += len;
+}
+
+uint32_t uart_dma_tx_write(const char *p_data, uint32_t len)
+{
+	uint32_t cycles = cycle_counter_get();
+	uint32_t free = uart_dma_tx_reserve();
+	uint32_t index;
+
+	if (free < len)
+	{
+		uart_dma_tx_abort(len - free);
+		len = free;
+	}
+
+	for (index = 0; len > index; index++)
+	{
+		uart_dma_tx_put(index, p_data[index]);
+	}
+	uart_dma_tx_stats.write_cycles += cycle_counter_get() - cycles;
+
+	uart_dma_tx_commit(len);
+
+	return len;
+}
+
+void uart_dma_tx_isr(void)
+{
+	uint32_t cycles = cycle_counter_get();
+	uint32_t isr = DMA1->ISR;
+	uint32_t half;
+
+	/* Half transfer: first half of the chunk already sent, give it back to the producer */
+	if (0 != (isr & DMA_ISR_HTIF7))
+	{
+		DMA1->IFCR = DMA_IFCR_CHTIF7;
+		half = uart_dma_tx_ring_.chunk / 2;
+		uart_dma_tx_ring_.tail += half - uart_dma_tx_ring_.released;
+		uart_dma_tx_ring_.released = half;
+	}
+
+	/* Transfer complete (or error): release the rest and chain the next chunk */
+	if (0 != (isr & (DMA_ISR_TCIF7 | DMA_ISR_TEIF7)))
+	{
+		DMA1->IFCR = DMA_IFCR_CTCIF7 | DMA_IFCR_CTEIF7 | DMA_IFCR_CGIF7;
+		uart_dma_tx_ring_.tail += uart_dma_tx_ring_.chunk - uart_dma_tx_ring_.released;
+		uart_dma_tx_stats.bytes_out += uart_dma_tx_ring_.chunk;
+
+		uart_dma_tx_start_();
+
+		if (false == uart_dma_tx_ring_.busy)
+		{
+			uart_dma_tx_stats.busy_ms += HAL_GetTick() - uart_dma_tx_ring_.tick_start;
+		}
+	}
+
+	uart_dma_tx_stats.isr_cycles += cycle_counter_get() - cycles;
+}
+
+/********************** end of file ******************************************/
@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : bench_active.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ *
+ * Host benchmark: active-instance bitmap (bitmap_next(), CTZ) of
+ * task_actuator_statechart() vs a full scan, 256 mostly idle actuators: a few of
+ * them blinking (tick counting) and one ON/OFF event every 16 ticks. Also checks
+ * that an event the state does not take (BLINK to an ON actuator) is dropped and
+ * the actuator leaves the active set (exit status).
+ * app/src/task_actuator.c & its back ends are built as they are (bench_task.h).
+ * The full scan is the same
+ * statechart with every active bit set before each tick, as the loop visited every
+ * actuator before the bitmap (each settled one is cleared again on the way).
+ *
+ * Build & run (host):
+ *  cc -O2 -std=gnu11 -DSTM32F103xB -DUSE_HAL_DRIVER -I../app/inc -I../Core/Inc \
+ *   -I../Drivers/STM32F1xx_HAL_Driver/Inc -I../Drivers/CMSIS/Device/ST/STM32F1xx/Include \
+ *   -I../Drivers/CMSIS/Include -o bench_active bench_active.c && ./bench_active
+ */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+
+/********************** macros and definitions *******************************/
+#define BENCH_QTY			(256ul)		/* actuators */
+#define BENCH_TICK_QTY		(200000ul)
+
+/********************** code under test **************************************/
+#include "bench_task.h"
+
+/********************** internal data definition *****************************/
+static uint32_t bench_visits_;
+
+/********************** internal functions definition ************************/
+/* GPIO LEDs spread over the five ports, 4 of them blinking */
+static void bench_setup_(void)
+{
+	uint32_t index;
+
+	for (index = 0; BENCH_QTY > index; index++)
+	{
+		task_actuator_cfg_list[index] = (task_actuator_cfg_t){(task_actuator_id_t)index,
+			(GPIO_TypeDef *)(GPIOA_BASE + (((index >> 4) % GPIO_STAGE_PORT_QTY) * GPIO_STAGE_PORT_STRIDE)),
+			(uint16_t)(1ul << (index & 15ul)), GPIO_PIN_SET, GPIO_PIN_RESET,
+			DEL_LED_XX_BLI, DEL_LED_XX_PUL,
+			KIND_LED_XX_GPIO, NULL, 0, LED_XX_BRIGHTNESS_MAX};
+	}
+
+	g_task_actuator_cnt = 0;
+	g_task_actuator_ev_dropped = 0;
+	task_actuator_init(NULL);
+	bench_visits_ = 0;
+
+	for (index = 0; BENCH_QTY > index; index += BENCH_QTY / 4)
+		put_event_task_actuator(EV_LED_XX_BLINK, (task_actuator_id_t)(index + 1));
+}
+
+/* One ON/OFF toggle every 16 ticks */
+static void bench_stimulus_(uint32_t tick)
+{
+	uint32_t index;
+
+	if (0 == (tick & 15ul))
+	{
+		index = ((tick >> 4) * 37ul) % BENCH_QTY;
+		if ((ST_LED_XX_OFF == TASK_ACTUATOR_DTA_STATE(index)) || (ST_LED_XX_ON == TASK_ACTUATOR_DTA_STATE(index)))
+			put_event_task_actuator((ST_LED_XX_ON == TASK_ACTUATOR_DTA_STATE(index)) ? EV_LED_XX_OFF : EV_LED_XX_ON,
+									(task_actuator_id_t)index);
+	}
+}
+
+/* One actuator pass, the statechart visits the actuators active on entry */
+static void bench_tick_(bool full_scan)
+{
+	uint32_t word;
+
+	if (true == full_scan)
+		memset(task_actuator_dta_active, 0xFF, sizeof(task_actuator_dta_active));
+
+	for (word = 0; BITMAP_WORDS(BENCH_QTY) > word; word++)
+		bench_visits_ += (uint32_t)__builtin_popcount(task_actuator_dta_active[word]);
+
+	g_task_actuator_tick_cnt = 1;
+	task_actuator_update(NULL);
+}
+
+static double bench_run_(bool full_scan)
+{
+	uint32_t tick;
+	uint64_t t0;
+
+	bench_setup_();
+	t0 = bench_now_ns();
+	for (tick = 0; BENCH_TICK_QTY > tick; tick++)
+	{
+		bench_stimulus_(tick);
+		bench_tick_(full_scan);
+	}
+	return (double)(bench_now_ns() - t0) / (double)BENCH_TICK_QTY;
+}
+
+/* An event the state does not take (ON + BLINK) is dropped, not left pending */
+static bool bench_ignored_event_(void)
+{
+	uint32_t index = 5;
+	uint32_t tick;
+
+	bench_setup_();
+	put_event_task_actuator(EV_LED_XX_ON, (task_actuator_id_t)index);
+	bench_tick_(false);
+	put_event_task_actuator(EV_LED_XX_BLINK, (task_actuator_id_t)index);
+	for (tick = 0; 3 > tick; tick++)
+		bench_tick_(false);
+
+	printf("ON + BLINK: state %lu pending %lu active %lu dropped %lu\n",
+		   (unsigned long)TASK_ACTUATOR_DTA_STATE(index), (unsigned long)TASK_ACTUATOR_DTA_FLAG(index),
+		   (unsigned long)bitmap_get(task_actuator_dta_active, index), (unsigned long)g_task_actuator_ev_dropped);
+
+	return (ST_LED_XX_ON == TASK_ACTUATOR_DTA_STATE(index)) && (false == TASK_ACTUATOR_DTA_FLAG(index)) &&
+		   (false == bitmap_get(task_actuator_dta_active, index)) && (1 == g_task_actuator_ev_dropped);
+}
+
+/********************** external functions definition ************************/
+int main(void)
+{
+	double ns_scan, ns_active;
+	uint32_t visits_scan, visits_active;
+	bool b_ok;
+
+	ns_scan = bench_run_(true);
+	visits_scan = bench_visits_;
+	ns_active = bench_run_(false);
+	visits_active = bench_visits_;
+
+	printf("%lu actuators, %lu ticks\n", (unsigned long)BENCH_QTY, (unsigned long)BENCH_TICK_QTY);
+	printf("%-12s %-14s %-16s\n", "", "[ns/tick]", "[visits/tick]");
+	printf("%-12s %-14.1f %-16.2f\n", "full scan", ns_scan, (double)visits_scan / (double)BENCH_TICK_QTY);
+	printf("%-12s %-14.1f %-16.2f\n", "active set", ns_active, (double)visits_active / (double)BENCH_TICK_QTY);
+
+	b_ok = bench_ignored_event_();
+	printf("ignored event %s\n", b_ok ? "ok" : "FAILED");
+
+	return b_ok ? 0 : 1;
+}
+
+/********************** end of file ******************************************/
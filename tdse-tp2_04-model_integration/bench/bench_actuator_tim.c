@@ -0,0 +1,236 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : bench_actuator_tim.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ *
+ * KIND_LED_XX_TIM backend check: app/src/task_actuator_tim.c built as it is (unity
+ * build) on stub registers (TIM1..TIM4, RCC), 64 MHz SYSCLK, APB1 / 2 as on the board.
+ * The header example actuator (PA6 => TIM3, channel 1) and an active low one on
+ * channel 2 are driven through init, blink, pulse, dimming, on & off, every timer
+ * register is compared with the value the reference manual asks for. TIM2
+ * (timer_service) & TIM4 (BAM) entries must be rejected and left untouched.
+ * Prints one line per check, exit status 1 on any mismatch.
+ *
+ * Build & run (host):
+ *  cc -O2 -std=gnu11 -DSTM32F103xB -DUSE_HAL_DRIVER -I../app/inc -I../Core/Inc \
+ *   -I../Drivers/STM32F1xx_HAL_Driver/Inc -I../Drivers/CMSIS/Device/ST/STM32F1xx/Include \
+ *   -I../Drivers/CMSIS/Include -o bench_actuator_tim bench_actuator_tim.c && ./bench_actuator_tim
+ */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+
+/********************** macros and definitions *******************************/
+/* Registers of the backend: RAM stubs */
+static TIM_TypeDef bench_tim_[4];
+static RCC_TypeDef bench_rcc_;
+
+#undef TIM1
+#define TIM1			(&bench_tim_[0])
+#undef TIM2
+#define TIM2			(&bench_tim_[1])
+#undef TIM3
+#define TIM3			(&bench_tim_[2])
+#undef TIM4
+#define TIM4			(&bench_tim_[3])
+#undef RCC
+#define RCC				(&bench_rcc_)
+
+/* No log output */
+#define LOGGER_MODULE_LEVEL		(-1)
+
+#define BENCH_CLOCK_HZ		(64000000ul)
+
+#define BENCH_OCM(tim, channel)	\
+	(((((channel) <= 2) ? (tim)->CCMR1 : (tim)->CCMR2) >> ((((channel) - 1) & 1) * 8 + TIM_CCMR1_OC1M_Pos)) & 7ul)
+
+/********************** code under test **************************************/
+#include "../app/src/task_actuator_tim.c"
+
+/********************** internal data definition *****************************/
+static uint32_t bench_fail_;
+
+/********************** HAL stubs ********************************************/
+uint32_t SystemCoreClock = BENCH_CLOCK_HZ;
+static uint32_t bench_clock_hz_ = BENCH_CLOCK_HZ;
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+	return bench_clock_hz_ / 2ul;
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+	return bench_clock_hz_;
+}
+
+/********************** internal functions definition ************************/
+static void bench_check_(const char *p_what, uint32_t value, uint32_t expected)
+{
+	bool ok = (value == expected);
+
+	printf("%-4s %-34s %10lu (expected %lu)\n", ok ? "ok" : "FAIL", p_what,
+		   (unsigned long)value, (unsigned long)expected);
+	if (false == ok)
+		bench_fail_++;
+}
+
+static bool bench_untouched_(const TIM_TypeDef *tim)
+{
+	static const TIM_TypeDef zero;
+
+	return (0 == memcmp(tim, &zero, sizeof(zero)));
+}
+
+/********************** external functions definition ************************/
+int main(void)
+{
+	task_actuator_cfg_t led_b = {ID_LED_A, GPIOA, GPIO_PIN_6, GPIO_PIN_SET, GPIO_PIN_RESET,
+								 500ul, 250ul, KIND_LED_XX_TIM, TIM3, 1, 50};
+	task_actuator_cfg_t led_c = {ID_LED_A, GPIOA, GPIO_PIN_7, GPIO_PIN_RESET, GPIO_PIN_SET,
+								 500ul, 250ul, KIND_LED_XX_TIM, TIM3, 2, LED_XX_BRIGHTNESS_MAX};
+	task_actuator_cfg_t bad;
+
+	/* Board clock tree: APB1 = HCLK / 2 => TIM2..4 clocked at 2 x PCLK1 */
+	RCC->CFGR = RCC_CFGR_PPRE1_DIV2;
+	bench_check_("TIM3 clock [Hz]", task_actuator_tim_clk(TIM3), BENCH_CLOCK_HZ);
+
+	/* init: clock on, counter stopped, forced inactive, active high output enabled */
+	bench_check_("init TIM3 ch1", task_actuator_tim_init(&led_b), true);
+	bench_check_("  RCC APB1ENR TIM3EN", RCC->APB1ENR & RCC_APB1ENR_TIM3EN, RCC_APB1ENR_TIM3EN);
+	bench_check_("  CR1", TIM3->CR1, 0);
+	bench_check_("  CCER", TIM3->CCER, TIM_CCER_CC1E);
+	bench_check_("  OC1M (force inactive)", BENCH_OCM(TIM3, 1), TIM_OCM_FORCE_INACTIVE);
+
+	/* blink: 0.1 mS counts, 2 x tick_blink period, 50 % duty, free running */
+	task_actuator_tim_blink(&led_b);
+	bench_check_("blink PSC", TIM3->PSC, (BENCH_CLOCK_HZ / 10000ul) - 1);
+	bench_check_("  ARR", TIM3->ARR, (2 * 5000ul) - 1);
+	bench_check_("  CCR1", TIM3->CCR1, 5000ul);
+	bench_check_("  OC1M (PWM 1)", BENCH_OCM(TIM3, 1), TIM_OCM_PWM1);
+	bench_check_("  CR1 CEN | OPM", TIM3->CR1 & (TIM_CR1_CEN | TIM_CR1_OPM), TIM_CR1_CEN);
+
+	/* pulse: one-pulse mode, active from CNT == 1 to the update, tick_pulse mS */
+	task_actuator_tim_pulse(&led_b);
+	bench_check_("pulse PSC", TIM3->PSC, (BENCH_CLOCK_HZ / 10000ul) - 1);
+	bench_check_("  ARR", TIM3->ARR, 2500ul);
+	bench_check_("  CCR1", TIM3->CCR1, 1);
+	bench_check_("  OC1M (PWM 2)", BENCH_OCM(TIM3, 1), TIM_OCM_PWM2);
+	bench_check_("  CR1 CEN | OPM", TIM3->CR1 & (TIM_CR1_CEN | TIM_CR1_OPM), TIM_CR1_CEN | TIM_CR1_OPM);
+	bench_check_("  busy", task_actuator_tim_busy(&led_b), true);
+	TIM3->CR1 &= ~TIM_CR1_CEN;		/* update event at the end of the pulse */
+	bench_check_("  busy after the update", task_actuator_tim_busy(&led_b), false);
+
+	/* on at 50 %: 1 KHz PWM, 1 uS counts */
+	task_actuator_tim_on(&led_b);
+	bench_check_("on 50 % PSC", TIM3->PSC, (BENCH_CLOCK_HZ / 1000000ul) - 1);
+	bench_check_("  ARR", TIM3->ARR, 999ul);
+	bench_check_("  CCR1", TIM3->CCR1, 500ul);
+	bench_check_("  CR1 CEN | OPM", TIM3->CR1 & (TIM_CR1_CEN | TIM_CR1_OPM), TIM_CR1_CEN);
+
+	/* dimming step while dimming: duty only, no UG (no counter restart) */
+	TIM3->EGR = 0;
+	task_actuator_tim_level(&led_b, 20);
+	bench_check_("level 20 % CCR1", TIM3->CCR1, 200ul);
+	bench_check_("  EGR (no restart)", TIM3->EGR, 0);
+
+	/* full level: counter stopped, forced active; off: forced inactive */
+	task_actuator_tim_level(&led_b, LED_XX_BRIGHTNESS_MAX);
+	bench_check_("level 100 % CR1 CEN", TIM3->CR1 & TIM_CR1_CEN, 0);
+	bench_check_("  OC1M (force active)", BENCH_OCM(TIM3, 1), TIM_OCM_FORCE_ACTIVE);
+	task_actuator_tim_off(&led_b);
+	bench_check_("off CR1 CEN", TIM3->CR1 & TIM_CR1_CEN, 0);
+	bench_check_("  OC1M (force inactive)", BENCH_OCM(TIM3, 1), TIM_OCM_FORCE_INACTIVE);
+
+	/* active low on channel 2: CC2P, OC2M in CCMR1[14:12], channel 1 kept */
+	bench_check_("init TIM3 ch2 active low", task_actuator_tim_init(&led_c), true);
+	bench_check_("  CCER", TIM3->CCER, TIM_CCER_CC1E | TIM_CCER_CC2E | TIM_CCER_CC2P);
+	task_actuator_tim_blink(&led_c);
+	bench_check_("  blink CCR2", TIM3->CCR2, 5000ul);
+	bench_check_("  OC2M (PWM 1)", BENCH_OCM(TIM3, 2), TIM_OCM_PWM1);
+	bench_check_("  OC1M (kept)", BENCH_OCM(TIM3, 1), TIM_OCM_FORCE_INACTIVE);
+
+	/* 72 MHz: PSC still within 16 bits, longest pulse clamped to the 16-bit ARR */
+	bench_clock_hz_ = 72000000ul;
+	task_actuator_tim_pulse(&led_b);
+	bench_check_("pulse @ 72 MHz PSC", TIM3->PSC, 7199ul);
+	bench_check_("  ARR", TIM3->ARR, 2500ul);
+	led_b.tick_pulse = 10000ul;
+	task_actuator_tim_pulse(&led_b);
+	bench_check_("pulse 10 S ARR (clamped)", TIM3->ARR, 65530ul);
+	led_b.tick_blink = 5000ul;
+	task_actuator_tim_blink(&led_b);
+	bench_check_("blink 5 S ARR (clamped)", TIM3->ARR, 65519ul);
+	bench_check_("  CCR1", TIM3->CCR1, 32760ul);
+	led_b.tick_pulse = 250ul;
+	led_b.tick_blink = 500ul;
+	bench_clock_hz_ = BENCH_CLOCK_HZ;
+
+	/* Owned timers & bad channels: rejected, registers untouched by every call */
+	bad = led_b;
+	bad.tim = TIM2;
+	bench_check_("init TIM2 (timer_service)", task_actuator_tim_init(&bad), false);
+	task_actuator_tim_on(&bad);
+	task_actuator_tim_blink(&bad);
+	task_actuator_tim_pulse(&bad);
+	task_actuator_tim_off(&bad);
+	bench_check_("  busy", task_actuator_tim_busy(&bad), false);
+	bench_check_("  TIM2 untouched", bench_untouched_(TIM2), true);
+
+	bad.tim = TIM4;
+	bench_check_("init TIM4 (BAM)", task_actuator_tim_init(&bad), false);
+	task_actuator_tim_level(&bad, 30);
+	task_actuator_tim_blink(&bad);
+	bench_check_("  TIM4 untouched", bench_untouched_(TIM4), true);
+
+	bad.tim = TIM1;
+	bad.tim_channel = 5;
+	bench_check_("init TIM1 channel 5", task_actuator_tim_init(&bad), false);
+	bench_check_("  TIM1 untouched", bench_untouched_(TIM1), true);
+
+	printf("%lu failed\n", (unsigned long)bench_fail_);
+
+	return (0 == bench_fail_) ? 0 : 1;
+}
+
+/********************** end of file ******************************************/
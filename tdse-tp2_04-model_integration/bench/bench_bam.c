@@ -0,0 +1,311 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : bench_bam.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ *
+ * Host benchmark: bit-angle modulation, app/src/task_actuator_bam.c built as it is
+ * (unity build) on stub registers (TIM4, RCC) & a RAM image of the GPIO ports, for
+ * 1 .. TASK_ACTUATOR_BAM_QTY_MAX LEDs spread over the five ports (worst case: one
+ * BSRR write per port in use). Every period runs TASK_ACTUATOR_BAM_BITS calls of
+ * task_actuator_bam_isr() and one level change + task_actuator_bam_update() (task
+ * context, masks double-buffered & swapped at the period boundary).
+ * Reports what the ISR itself records on target in task_actuator_bam_stats
+ * (isr_cycles_last, here on the host time stamp counter instead of DWT->CYCCNT, read
+ * overhead removed): min & mean per call (the host max is preemption noise, on target
+ * isr_cycles_max is exact), the mask rebuild and, as the reference, a per-LED
+ * soft-PWM interrupt (one compare per LED, 2^BITS - 1 interrupts per period).
+ *
+ * Build & run (host):
+ *  cc -O2 -std=gnu11 -DSTM32F103xB -DUSE_HAL_DRIVER -I../app/inc -I../Core/Inc \
+ *   -I../Drivers/STM32F1xx_HAL_Driver/Inc -I../Drivers/CMSIS/Device/ST/STM32F1xx/Include \
+ *   -I../Drivers/CMSIS/Include -o bench_bam bench_bam.c && ./bench_bam
+ */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "main.h"
+
+/********************** macros and definitions *******************************/
+/* Registers of the code under test: RAM stubs */
+static TIM_TypeDef bench_tim4_;
+static RCC_TypeDef bench_rcc_;
+
+#undef TIM4
+#define TIM4			(&bench_tim4_)
+#undef RCC
+#define RCC				(&bench_rcc_)
+
+/* GPIOA .. GPIOE: RAM image, same stride (before gpio_stage.h, its inline writes) */
+static uint8_t bench_gpio_[5][0x400] __attribute__((aligned(4)));
+
+#undef GPIOA_BASE
+#define GPIOA_BASE		((uintptr_t)bench_gpio_)
+#undef GPIOB_BASE
+#define GPIOB_BASE		(GPIOA_BASE + 0x400ul)
+
+#if !defined(__arm__)
+#define __DMB()			__sync_synchronize()
+#endif
+
+/* No log output */
+#define LOGGER_MODULE_LEVEL		(-1)
+
+#define BENCH_PERIOD_QTY	(20000ul)
+#define BENCH_WARMUP_QTY	(100ul)
+
+/********************** code under test **************************************/
+#include "dwt.h"
+
+/* CYCCNT does not count on the host: the ISR stamps come from the bench counter */
+static inline uint32_t bench_cycles_(void);
+#define cycle_counter_get()		bench_cycles_()
+
+#include "task_actuator_attribute.h"
+
+/* Each module sets its own LOGGER_MODULE */
+#include "../app/src/gpio_stage.c"
+#include "../app/src/task_actuator_tim.c"
+#undef LOGGER_MODULE
+#include "../app/src/task_actuator_bam.c"
+
+#undef cycle_counter_get
+
+/********************** internal data definition *****************************/
+static task_actuator_cfg_t bench_cfg_list_[TASK_ACTUATOR_BAM_QTY_MAX];
+static uint8_t bench_level_[TASK_ACTUATOR_BAM_QTY_MAX];
+static uint32_t bench_overhead_;
+
+/********************** platform *********************************************/
+#if defined(__x86_64__) || defined(__i386__)
+#define BENCH_UNIT	"TSC cycles"
+
+static inline uint32_t bench_cycles_(void)
+{
+	return (uint32_t)__rdtsc();
+}
+#else
+#define BENCH_UNIT	"nS"
+
+static inline uint32_t bench_cycles_(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec);
+}
+#endif
+
+/********************** HAL stubs ********************************************/
+uint32_t SystemCoreClock = 64000000ul;
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+	return SystemCoreClock / 2ul;
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+	return SystemCoreClock;
+}
+
+/********************** internal functions definition ************************/
+/* Cost of the two counter reads around the ISR body, smallest of many */
+static uint32_t bench_overhead_measure_(void)
+{
+	uint32_t i, cycles, best = UINT32_MAX;
+
+	for (i = 0; 10000ul > i; i++)
+	{
+		cycles = bench_cycles_();
+		cycles = bench_cycles_() - cycles;
+		if (best > cycles)
+		{
+			best = cycles;
+		}
+	}
+	return best;
+}
+
+static uint32_t bench_net_(uint32_t cycles)
+{
+	return (cycles > bench_overhead_) ? (cycles - bench_overhead_) : 0;
+}
+
+/* qty LEDs on the BAM, LED i on port i % 5, pin i / 5, task_actuator_init() order */
+static void bench_setup_(uint32_t qty)
+{
+	uint32_t index;
+
+	task_actuator_bam_init();
+
+	for (index = 0; qty > index; index++)
+	{
+		bench_cfg_list_[index] = (task_actuator_cfg_t){(task_actuator_id_t)index,
+			(GPIO_TypeDef *)(GPIOA_BASE + ((index % GPIO_STAGE_PORT_QTY) * GPIO_STAGE_PORT_STRIDE)),
+			(uint16_t)(1ul << (index / GPIO_STAGE_PORT_QTY)), GPIO_PIN_SET, GPIO_PIN_RESET,
+			500ul, 250ul, KIND_LED_XX_BAM, NULL, 0, LED_XX_BRIGHTNESS_MAX};
+		task_actuator_bam_attach(index, &bench_cfg_list_[index]);
+
+		bench_level_[index] = (uint8_t)((index * 37ul) % (LED_XX_BRIGHTNESS_MAX + 1));
+		task_actuator_bam_level(index, bench_level_[index]);
+	}
+
+	task_actuator_bam_update();
+	task_actuator_bam_start();
+}
+
+/* Per-LED soft-PWM interrupt, for reference: every LED compared in every slice */
+static void bench_soft_pwm_isr_(uint32_t qty, uint32_t slice)
+{
+	uint32_t bsrr[GPIO_STAGE_PORT_QTY] = {0};
+	uint32_t index, port, pin;
+
+	for (index = 0; qty > index; index++)
+	{
+		port = index % GPIO_STAGE_PORT_QTY;
+		pin = 1ul << (index / GPIO_STAGE_PORT_QTY);
+		bsrr[port] |= (task_actuator_bam_dta_list[index].level > slice) ? pin : (pin << 16);
+	}
+	for (port = 0; GPIO_STAGE_PORT_QTY > port; port++)
+	{
+		if (0 != bsrr[port])
+		{
+			BAM_PORT(port)->BSRR = bsrr[port];
+		}
+	}
+}
+
+/********************** external functions definition ************************/
+int main(void)
+{
+	uint32_t qty, period, bit, index, cycles;
+	uint64_t isr_sum, update_sum, soft_sum;
+	uint32_t isr_min, update_min;
+
+	bench_overhead_ = bench_overhead_measure_();
+
+	printf("unit: %s, counter read overhead %lu removed\n", BENCH_UNIT, (unsigned long)bench_overhead_);
+	printf("%-6s %-7s %-10s %-10s %-12s %-12s %-20s\n", "LEDs", "ports", "ISR min", "ISR mean",
+		   "update min", "update mean", "soft-PWM ISR mean");
+
+	for (qty = 1; TASK_ACTUATOR_BAM_QTY_MAX >= qty; qty = (qty < 4) ? (qty + 1) : (qty + 4))
+	{
+		bench_setup_(qty);
+
+		isr_sum = 0;
+		isr_min = UINT32_MAX;
+		update_sum = 0;
+		update_min = UINT32_MAX;
+		for (period = 0; (BENCH_WARMUP_QTY + BENCH_PERIOD_QTY) > period; period++)
+		{
+			/* TIM4 updates of one period */
+			for (bit = 0; TASK_ACTUATOR_BAM_BITS > bit; bit++)
+			{
+				task_actuator_bam_isr();
+				if (BENCH_WARMUP_QTY <= period)
+				{
+					cycles = bench_net_(task_actuator_bam_stats.isr_cycles_last);
+					isr_sum += cycles;
+					if (isr_min > cycles)
+					{
+						isr_min = cycles;
+					}
+				}
+			}
+
+			/* One level change per period, rebuilt at the end of the actuator pass */
+			index = period % qty;
+			bench_level_[index] = (uint8_t)((bench_level_[index] + 1u) % (LED_XX_BRIGHTNESS_MAX + 1));
+			task_actuator_bam_level(index, bench_level_[index]);
+
+			cycles = bench_cycles_();
+			task_actuator_bam_update();
+			cycles = bench_net_(bench_cycles_() - cycles);
+			if (BENCH_WARMUP_QTY <= period)
+			{
+				update_sum += cycles;
+				if (update_min > cycles)
+				{
+					update_min = cycles;
+				}
+			}
+		}
+
+		/* Reference: 2^BITS - 1 soft-PWM interrupts per period */
+		soft_sum = 0;
+		for (period = 0; (BENCH_PERIOD_QTY / 16ul) > period; period++)
+		{
+			for (bit = 0; BAM_LEVEL_MAX > bit; bit++)
+			{
+				cycles = bench_cycles_();
+				bench_soft_pwm_isr_(qty, bit);
+				soft_sum += bench_net_(bench_cycles_() - cycles);
+			}
+		}
+
+		printf("%-6lu %-7lu %-10lu %-10.1f %-12lu %-12.1f %-20.1f\n", (unsigned long)qty,
+			   (unsigned long)task_actuator_bam_stats.port_qty, (unsigned long)isr_min,
+			   (double)isr_sum / (double)(BENCH_PERIOD_QTY * TASK_ACTUATOR_BAM_BITS),
+			   (unsigned long)update_min, (double)update_sum / (double)BENCH_PERIOD_QTY,
+			   (double)soft_sum / (double)((BENCH_PERIOD_QTY / 16ul) * BAM_LEVEL_MAX));
+	}
+
+	return 0;
+}
+
+/********************** end of file ******************************************/
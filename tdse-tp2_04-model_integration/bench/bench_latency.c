@@ -0,0 +1,347 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : bench_latency.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ *
+ * Latency harness check: app/src/latency.c built as it is (unity build) on stub
+ * registers (DWT, SysTick), driven by a simulated 64 MHz timeline with synthetic
+ * interrupt injection:
+ *  - SysTick every mS, entry delayed by stacking, interrupt disable windows of the
+ *    thread code & a higher priority handler (TIM4 bit-angle modulation)
+ *  - app_update() releases task_sensor_update() after the SysTick handler, at the
+ *    end of the idle pass in progress (logger drain), or late after a tick overrun
+ *  - B1 edges (EXTI15_10, with bounces) every ~150 mS, the LED changes at the end
+ *    of the actuator pass of the tick that completes the debounce
+ * The hooks see the simulated CYCCNT & SysTick->VAL, each sample is also kept
+ * exactly: the harness min/p50/p99/max are printed next to the exact ones.
+ * Deterministic (fixed seed), same numbers on the host & under QEMU.
+ *
+ * Build & run (host):
+ *  cc -O2 -std=gnu11 -DSTM32F103xB -DUSE_HAL_DRIVER -I../app/inc -I../Core/Inc \
+ *   -I../Drivers/STM32F1xx_HAL_Driver/Inc -I../Drivers/CMSIS/Device/ST/STM32F1xx/Include \
+ *   -I../Drivers/CMSIS/Include -o bench_latency bench_latency.c && ./bench_latency
+ *
+ * Build & run (QEMU Cortex-M3, semihosting output):
+ *  arm-none-eabi-gcc -mcpu=cortex-m3 -mthumb -O2 -std=gnu11 --specs=rdimon.specs \
+ *   -Wl,--section-start=.vectors=0 -DSTM32F103xB -DUSE_HAL_DRIVER <same -I> \
+ *   -o bench_latency.elf bench_latency.c
+ *  qemu-system-arm -M mps2-an385 -nographic -semihosting -kernel bench_latency.elf
+ */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "main.h"
+
+/********************** macros and definitions *******************************/
+/* Registers of the code under test: RAM stubs */
+static DWT_Type bench_dwt_;
+static CoreDebug_Type bench_core_debug_;
+static SysTick_Type bench_systick_;
+
+#undef DWT
+#define DWT				(&bench_dwt_)
+#undef CoreDebug
+#define CoreDebug		(&bench_core_debug_)
+#undef SysTick
+#define SysTick			(&bench_systick_)
+
+/* No log output */
+#define LOGGER_MODULE_LEVEL		(-1)
+
+#define BENCH_CLOCK_HZ		(64000000ul)
+#define BENCH_PERIOD		(BENCH_CLOCK_HZ / 1000ul)	/* cycles per tick */
+#define BENCH_TICK_QTY		(60000ul)					/* 1 minute */
+#define BENCH_SAMPLE_QTY	(BENCH_TICK_QTY + 1ul)
+#define BENCH_STACKING		(12ul)		/* exception entry, zero wait state */
+#define BENCH_SYSTICK_ISR	(180ul)		/* SysTick_Handler() */
+#define BENCH_EXTI_ISR		(150ul)		/* EXTI15_10_IRQHandler() */
+#define BENCH_EDGE_MS		(150ul)		/* mean time between B1 edges */
+#define BENCH_DEBOUNCE_MS	(50ul)		/* tick_max */
+
+/********************** code under test **************************************/
+#include "../app/src/dwt.c"
+#include "../app/src/latency.c"
+
+/********************** internal data declaration ****************************/
+typedef struct
+{
+	uint32_t	qty;
+	uint32_t	list[BENCH_SAMPLE_QTY];
+} bench_exact_t;
+
+/********************** internal data definition *****************************/
+static bench_exact_t bench_exact_[LATENCY_PROBE_QTY];
+static uint64_t bench_now_;
+static uint32_t bench_seed_ = 0x2545F491ul;
+
+/********************** platform *********************************************/
+#if defined(__arm__)
+/* mps2-an385 boots from 0: initial SP & reset (newlib rdimon crt0) */
+extern void _start(void);
+static uint32_t bench_stack_[1024];
+
+__attribute__((section(".vectors"), used))
+static void * const bench_vectors_[] =
+{
+	&bench_stack_[1024],
+	(void *)_start,
+};
+#endif
+
+/********************** HAL stubs ********************************************/
+uint32_t SystemCoreClock = BENCH_CLOCK_HZ;
+
+/********************** internal functions definition ************************/
+/* xorshift32, uniform in [0, range) */
+static uint32_t bench_rand_(uint32_t range)
+{
+	bench_seed_ ^= bench_seed_ << 13;
+	bench_seed_ ^= bench_seed_ >> 17;
+	bench_seed_ ^= bench_seed_ << 5;
+	return (0 == range) ? 0 : (bench_seed_ % range);
+}
+
+static bool bench_chance_(uint32_t per_mille)
+{
+	return (bench_rand_(1000) < per_mille);
+}
+
+/* Simulated time seen by the hooks */
+static void bench_at_(uint64_t now, uint64_t reload)
+{
+	bench_now_ = now;
+	bench_dwt_.CYCCNT = (uint32_t)now;
+	bench_systick_.VAL = bench_systick_.LOAD - (uint32_t)((now - reload) % BENCH_PERIOD);
+}
+
+static void bench_exact_add_(latency_probe_t probe, uint32_t cycles)
+{
+	bench_exact_t *p_exact = &bench_exact_[probe];
+
+	if (BENCH_SAMPLE_QTY > p_exact->qty)
+	{
+		p_exact->list[p_exact->qty++] = cycles;
+	}
+}
+
+/* Exception entry: stacking, a disable window of the thread code or a higher
+ * priority handler in progress */
+static uint32_t bench_entry_(void)
+{
+	uint32_t delay = BENCH_STACKING;
+
+	if (bench_chance_(60))
+	{
+		delay += bench_rand_(60);		/* logger ring put, tick counters */
+	}
+	if (bench_chance_(2))
+	{
+		delay += bench_rand_(2500);		/* synchronous log line */
+	}
+	if (bench_chance_(30))
+	{
+		delay += bench_rand_(160);		/* TIM4 bit-angle modulation */
+	}
+	return delay;
+}
+
+/* Idle pass of app_update(): logger drain, trace dump, stack scan */
+static uint32_t bench_idle_pass_(void)
+{
+	return bench_chance_(100) ? (300 + bench_rand_(3000)) : (200 + bench_rand_(120));
+}
+
+static int bench_cmp_(const void *p_a, const void *p_b)
+{
+	uint32_t a = *(const uint32_t *)p_a;
+	uint32_t b = *(const uint32_t *)p_b;
+
+	return (a > b) - (a < b);
+}
+
+static void bench_exact_stat_(bench_exact_t *p_exact, latency_stat_t *p_stat)
+{
+	uint32_t qty = p_exact->qty;
+
+	memset(p_stat, 0, sizeof(latency_stat_t));
+	p_stat->count = qty;
+	if (0 == qty)
+	{
+		return;
+	}
+
+	/* Same ranks as latency_stat() */
+	qsort(p_exact->list, qty, sizeof(uint32_t), bench_cmp_);
+	p_stat->min = p_exact->list[0];
+	p_stat->p50 = p_exact->list[(qty + 1) / 2 - 1];
+	p_stat->p99 = p_exact->list[qty - (qty / 100) - 1];
+	p_stat->max = p_exact->list[qty - 1];
+}
+
+static void bench_run_(void)
+{
+	uint64_t reload;
+	uint64_t entry;
+	uint64_t release;
+	uint64_t busy_end = 0;
+	uint64_t release_last = 0;
+	uint64_t edge = (uint64_t)BENCH_EDGE_MS * BENCH_PERIOD;
+	uint64_t edge_entry = 0;
+	uint64_t output_at = UINT64_MAX;
+	uint32_t tick;
+	uint32_t bounce;
+	uint32_t cycles;
+
+	for (tick = 1; BENCH_TICK_QTY >= tick; tick++)
+	{
+		reload = (uint64_t)tick * BENCH_PERIOD;
+
+		/* B1 edges of the mS before this SysTick: the first one & its bounces */
+		while (edge < reload)
+		{
+			cycles = bench_entry_();
+			bench_at_(edge + cycles, reload - BENCH_PERIOD);
+			if (false == latency_exti_pending_)
+			{
+				edge_entry = bench_now_;
+				output_at = UINT64_MAX;
+			}
+			latency_exti_isr();
+
+			for (bounce = bench_rand_(4); 0 < bounce; bounce--)
+			{
+				cycles = BENCH_EXTI_ISR + bench_rand_(4000);
+				if (reload <= bench_now_ + cycles)
+				{
+					break;
+				}
+				bench_at_(bench_now_ + cycles, reload - BENCH_PERIOD);
+				latency_exti_isr();
+			}
+
+			/* Debounce done at the tick after tick_max mS, LED at the end of that pass */
+			output_at = ((edge / BENCH_PERIOD) + BENCH_DEBOUNCE_MS + 1) * BENCH_PERIOD;
+			edge += (uint64_t)(BENCH_EDGE_MS / 2 + bench_rand_(BENCH_EDGE_MS)) * BENCH_PERIOD
+				  + bench_rand_(BENCH_PERIOD);
+		}
+
+		/* SysTick */
+		cycles = bench_entry_();
+		entry = reload + cycles;
+		bench_at_(entry, reload);
+		bench_exact_add_(LATENCY_PROBE_SYSTICK_ENTRY, (uint32_t)(entry - reload));
+		latency_systick_isr();
+
+		/* app_update(): after the overrun, or at the end of the idle pass in progress */
+		release = entry + BENCH_SYSTICK_ISR;
+		if (busy_end > release)
+		{
+			release = busy_end;
+		}
+		else
+		{
+			release += bench_rand_(bench_idle_pass_());
+		}
+		release += 24;
+		bench_at_(release, reload);
+		bench_exact_add_(LATENCY_PROBE_TICK_RELEASE, (uint32_t)(release - entry));
+		if (0 < release_last)
+		{
+			cycles = (uint32_t)(release - release_last);
+			bench_exact_add_(LATENCY_PROBE_TICK_JITTER,
+							 (cycles > BENCH_PERIOD) ? (cycles - BENCH_PERIOD) : (BENCH_PERIOD - cycles));
+		}
+		release_last = release;
+		latency_task_release();
+
+		/* Tasks: sensor, system (rarely overrunning), actuator */
+		busy_end = release + 300 + bench_rand_(400) + 250 + bench_rand_(200);
+		if (bench_chance_(3))
+		{
+			busy_end += 40000 + bench_rand_(60000);
+		}
+		busy_end += 400 + bench_rand_(400);
+
+		if (output_at == reload)
+		{
+			bench_at_(busy_end, reload);
+			bench_exact_add_(LATENCY_PROBE_EXTI_OUTPUT, (uint32_t)(busy_end - edge_entry));
+			latency_output();
+			output_at = UINT64_MAX;
+		}
+	}
+}
+
+static void bench_print_(const char *p_name, const latency_stat_t *p_stat)
+{
+	printf("%-14s %6lu %8lu %8lu %8lu %8lu\n", p_name, (unsigned long)p_stat->count,
+		   (unsigned long)p_stat->min, (unsigned long)p_stat->p50,
+		   (unsigned long)p_stat->p99, (unsigned long)p_stat->max);
+}
+
+/********************** external functions definition ************************/
+int main(void)
+{
+	latency_stat_t stat;
+	uint32_t index;
+
+	bench_systick_.LOAD = BENCH_PERIOD - 1;
+	cycle_counter_init();
+	latency_init();
+
+	bench_run_();
+
+	printf("latency: %lu mS simulated, cycles at %lu MHz\n\n", (unsigned long)BENCH_TICK_QTY,
+		   (unsigned long)(BENCH_CLOCK_HZ / 1000000ul));
+	printf("probe               n      min      p50      p99      max\n");
+	for (index = 0; LATENCY_PROBE_QTY > index; index++)
+	{
+		latency_get((latency_probe_t)index, &stat);
+		bench_print_(latency_probe_name_[index], &stat);
+		if (0 < bench_exact_[index].qty)
+		{
+			bench_exact_stat_(&bench_exact_[index], &stat);
+			bench_print_("  exact", &stat);
+		}
+	}
+
+	return 0;
+}
+
+/********************** end of file ******************************************/
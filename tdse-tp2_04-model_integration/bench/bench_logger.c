@@ -0,0 +1,557 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : bench_logger.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ *
+ * Logger benchmark: app/src/logger.c & app/src/uart_dma_tx.c built as they are
+ * (unity build) on stub registers (DWT, CoreDebug, DMA1 channel 7, USART2), with
+ * a model of the DMA draining USART2 at 115200 8N1 (11.52 bytes per mS).
+ *  - cost per LOGGER_INFO() for 0, 1, 4 & 8 arguments and per sink (null, UART
+ *    DMA, UART polling, semihosting): the call (ring put, or the whole line when
+ *    not deferred) and the logger_drain() of the record (format & output)
+ *  - sustained messages/S with no drop over 30 S of simulated time and a backlog
+ *    (logger ring & transport ring) that does not grow: the peak of the last second
+ *    is not above the peak of the first one (the rings only absorb a burst, a rate
+ *    above the line rate fills them & drops after a while), one
+ *    logger_drain(LOGGER_CONFIG_DRAIN_QTY) per mS tick (the idle path worst case)
+ *  - worst interrupt disable window: every "CPSID i" .. "CPSIE i" in the logger &
+ *    the transport is timed through a hook on __asm()
+ * The logger build is picked on the command line: deferred text (default),
+ * binary ring (-DLOGGER_CONFIG_TOKENIZED=1) or synchronous (-DLOGGER_CONFIG_DEFERRED=0).
+ * Units: nS on the host (clock_gettime()), SysTick ticks under QEMU (processor
+ * clock, 25 MHz on mps2-an385: with "-icount shift=0" 1 tick = 40 instructions).
+ * UART polling does not model the line time (86.8 uS per byte blocked on target),
+ * semihosting is stdio on the host (stdout is discarded, results go to stderr).
+ *
+ * Build & run (host):
+ *  cc -O2 -std=gnu11 -DSTM32F103xB -DUSE_HAL_DRIVER -I../app/inc -I../Core/Inc \
+ *   -I../Drivers/STM32F1xx_HAL_Driver/Inc -I../Drivers/CMSIS/Device/ST/STM32F1xx/Include \
+ *   -I../Drivers/CMSIS/Include -o bench_logger bench_logger.c && ./bench_logger
+ *
+ * Build & run (QEMU Cortex-M3, semihosting output):
+ *  arm-none-eabi-gcc -mcpu=cortex-m3 -mthumb -O2 -std=gnu11 --specs=rdimon.specs \
+ *   -Wl,--section-start=.vectors=0 -DSTM32F103xB -DUSE_HAL_DRIVER <same -I> \
+ *   -o bench_logger.elf bench_logger.c
+ *  qemu-system-arm -M mps2-an385 -nographic -semihosting -icount shift=0 \
+ *   -kernel bench_logger.elf > /dev/null
+ */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <time.h>
+
+#include "main.h"
+
+/********************** macros and definitions *******************************/
+/* Registers of the logger & the transport: RAM stubs */
+static DWT_Type bench_dwt_;
+static CoreDebug_Type bench_core_debug_;
+static DMA_TypeDef bench_dma_;
+static DMA_Channel_TypeDef bench_dma_channel_;
+static USART_TypeDef bench_usart_;
+
+#undef DWT
+#define DWT				(&bench_dwt_)
+#undef CoreDebug
+#define CoreDebug		(&bench_core_debug_)
+#undef DMA1
+#define DMA1			(&bench_dma_)
+#undef DMA1_Channel7
+#define DMA1_Channel7	(&bench_dma_channel_)
+#undef USART2
+#define USART2			(&bench_usart_)
+
+#if !defined(__arm__)
+#define __DMB()			__sync_synchronize()
+#endif
+
+/* Interrupt disable windows of the code under test */
+static void bench_irq_(const char *p_insn);
+#define __asm(insn)		bench_irq_(insn)
+
+#define BENCH_BATCH			(LOGGER_CONFIG_RING_QTY / 2)
+#define BENCH_ROUNDS		(64ul)
+#define BENCH_REPEAT		(8ul)	/* best of: host preemption & cache noise */
+#define BENCH_SECOND_MS		(1000ul)
+#define BENCH_SUSTAIN_S		(30ul)
+#define BENCH_LINE_SLACK	(64ul)		/* bytes: lines widen as the logged values grow */
+#define BENCH_RATE_MAX		(20000ul)	/* msgs/S */
+#define BENCH_UART_BYTES_MS	(1152ul)	/* 1/100 bytes per mS, 115200 8N1 */
+
+/********************** code under test **************************************/
+#include "../app/src/dwt.c"
+#include "../app/src/uart_dma_tx.c"
+#include "../app/src/logger.c"
+
+#undef __asm
+
+/********************** internal data declaration ****************************/
+typedef struct
+{
+	logger_sink_t	sink;
+	const char		*p_name;
+	bool			sustained;	/* rate meaningful in simulated time */
+} bench_sink_t;
+
+/********************** internal data definition *****************************/
+static const bench_sink_t bench_sink_list_[] =
+{
+	{LOGGER_SINK_NULL,			"null",			true},
+	{LOGGER_SINK_UART,			"uart-dma",		true},
+	{LOGGER_SINK_UART_POLL,		"uart-poll",	false},
+	{LOGGER_SINK_SEMIHOSTING,	"semihosting",	false},
+};
+
+static const uint32_t bench_argc_list_[] = {0, 1, 4, 8};
+
+static uint32_t bench_ms_;
+static uint64_t bench_now_overhead_;
+static bool bench_irq_off_;
+static uint64_t bench_irq_off_start_;
+static uint64_t bench_irq_off_max_;
+
+/* DMA model: bytes left of the transfer in flight, its length, byte budget */
+static uint32_t bench_dma_left_;
+static uint32_t bench_dma_len_;
+static uint32_t bench_dma_credit_;
+
+/********************** platform *********************************************/
+#if defined(__arm__)
+static uint32_t bench_systick_last_;
+static uint64_t bench_systick_ext_;
+
+/* 24-bit SysTick down counter extended in software (read often enough) */
+static uint64_t bench_now_(void)
+{
+	uint32_t val = SysTick->VAL;
+
+	bench_systick_ext_ += (bench_systick_last_ - val) & SysTick_LOAD_RELOAD_Msk;
+	bench_systick_last_ = val;
+	return bench_systick_ext_;
+}
+
+static void bench_platform_init_(void)
+{
+	SysTick->LOAD = SysTick_LOAD_RELOAD_Msk;
+	SysTick->VAL = 0;
+	SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+	bench_systick_last_ = SysTick->VAL;
+}
+
+#define BENCH_UNIT	"ticks"
+
+/* mps2-an385 boots from 0: initial SP & reset (newlib rdimon crt0) */
+extern void _start(void);
+static uint32_t bench_stack_[1024];
+
+__attribute__((section(".vectors"), used))
+static void * const bench_vectors_[] =
+{
+	&bench_stack_[1024],
+	(void *)_start,
+};
+
+static void bench_irq_(const char *p_insn)
+{
+	if ('D' == p_insn[4])
+	{
+		__disable_irq();
+		if (false == bench_irq_off_)
+		{
+			bench_irq_off_ = true;
+			bench_irq_off_start_ = bench_now_();
+		}
+	}
+	else
+	{
+		if (true == bench_irq_off_)
+		{
+			uint64_t off = bench_now_() - bench_irq_off_start_;
+
+			bench_irq_off_ = false;
+			if (bench_irq_off_max_ < off)
+			{
+				bench_irq_off_max_ = off;
+			}
+		}
+		__enable_irq();
+	}
+}
+#else
+static uint64_t bench_now_(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static void bench_platform_init_(void)
+{
+	/* Semihosting sink output */
+	freopen("/dev/null", "w", stdout);
+}
+
+#define BENCH_UNIT	"nS"
+
+static void bench_irq_(const char *p_insn)
+{
+	if ('D' == p_insn[4])
+	{
+		if (false == bench_irq_off_)
+		{
+			bench_irq_off_ = true;
+			bench_irq_off_start_ = bench_now_();
+		}
+	}
+	else if (true == bench_irq_off_)
+	{
+		uint64_t off = bench_now_() - bench_irq_off_start_;
+
+		bench_irq_off_ = false;
+		if (bench_irq_off_max_ < off)
+		{
+			bench_irq_off_max_ = off;
+		}
+	}
+}
+#endif
+
+/********************** HAL stubs ********************************************/
+uint32_t SystemCoreClock = 64000000ul;
+
+uint32_t HAL_GetTick(void)
+{
+	return bench_ms_;
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+}
+
+/********************** internal functions definition ************************/
+/* DMA1 channel 7 => USART2: "bytes" leave the ring, half & full transfer interrupts */
+static void bench_dma_run_(uint32_t bytes)
+{
+	while (0 < bytes)
+	{
+		if (0 == bench_dma_left_)
+		{
+			/* Next transfer programmed by uart_dma_tx_start_() */
+			if ((0 == (bench_dma_channel_.CCR & DMA_CCR_EN)) || (0 == bench_dma_channel_.CNDTR))
+			{
+				break;
+			}
+			bench_dma_len_ = bench_dma_channel_.CNDTR;
+			bench_dma_left_ = bench_dma_len_;
+		}
+
+		bench_dma_left_--;
+		bench_dma_channel_.CNDTR = bench_dma_left_;
+		bytes--;
+
+		if ((0 < bench_dma_left_) && ((bench_dma_len_ / 2) == bench_dma_left_))
+		{
+			bench_dma_.ISR = DMA_ISR_HTIF7;
+			uart_dma_tx_isr();
+		}
+		else if (0 == bench_dma_left_)
+		{
+			bench_dma_.ISR = DMA_ISR_TCIF7;
+			uart_dma_tx_isr();
+		}
+		bench_dma_.ISR = 0;
+	}
+}
+
+/* One mS of line time */
+static void bench_dma_tick_(void)
+{
+	bench_dma_credit_ += BENCH_UART_BYTES_MS;
+	bench_dma_run_(bench_dma_credit_ / 100);
+	bench_dma_credit_ %= 100;
+	bench_ms_++;
+}
+
+/* Empty the logger ring & the transport, clear the counters */
+static void bench_reset_(void)
+{
+	logger_sink_t sink = logger_sink_get();
+
+	logger_sink_set(LOGGER_SINK_NULL);
+	while (0 < logger_drain(LOGGER_CONFIG_RING_QTY))
+	{
+	}
+	logger_sink_set(sink);
+
+	bench_dma_run_(UINT32_MAX);
+	memset(&logger_stats, 0, sizeof(logger_stats));
+	memset(&uart_dma_tx_stats, 0, sizeof(uart_dma_tx_stats));
+	bench_dma_credit_ = 0;
+	bench_irq_off_max_ = 0;
+}
+
+static void bench_log_(uint32_t argc, uint32_t value)
+{
+	switch (argc)
+	{
+		case 0:
+			LOGGER_INFO("sensor event");
+			break;
+
+		case 1:
+			LOGGER_INFO("sensor event %u", value);
+			break;
+
+		case 4:
+			LOGGER_INFO("sensor %u event %u state %x %s", value, value & 7u, value * 3u, "BUTTON");
+			break;
+
+		default:
+			LOGGER_INFO("%u %u %u %u %x %x %x %s", value, value + 1u, value + 2u, value + 3u,
+						value, value >> 1, value >> 2, "BUTTON");
+			break;
+	}
+}
+
+/* Clock read cost, subtracted from every timed section */
+static void bench_calibrate_(void)
+{
+	uint64_t start;
+	uint64_t delta;
+	uint32_t index;
+
+	bench_now_overhead_ = UINT64_MAX;
+	for (index = 0; 1000 > index; index++)
+	{
+		start = bench_now_();
+		delta = bench_now_() - start;
+		if (bench_now_overhead_ > delta)
+		{
+			bench_now_overhead_ = delta;
+		}
+	}
+}
+
+static uint64_t bench_since_(uint64_t start)
+{
+	uint64_t delta = bench_now_() - start;
+
+	return (delta > bench_now_overhead_) ? (delta - bench_now_overhead_) : 0;
+}
+
+/* Cost per message: the call & the drain of its record, one at a time through the
+ * transport (the DMA empties it in between, wire time is not CPU time), bytes per
+ * message on the wire. Best of BENCH_REPEAT runs. */
+static void bench_cost_(const bench_sink_t *p_sink, uint32_t argc)
+{
+	uint64_t call;
+	uint64_t drain;
+	uint64_t call_min = UINT64_MAX;
+	uint64_t drain_min = UINT64_MAX;
+	uint64_t irq_off_min = UINT64_MAX;
+	uint64_t start;
+	uint32_t repeat;
+	uint32_t round;
+	uint32_t index;
+	uint32_t qty = BENCH_ROUNDS * BENCH_BATCH;
+
+	logger_sink_set(p_sink->sink);
+	if (p_sink->sink != logger_sink_get())
+	{
+		fprintf(stderr, "%-12s %4lu   (not available)\n", p_sink->p_name, (unsigned long)argc);
+		return;
+	}
+
+	for (repeat = 0; BENCH_REPEAT > repeat; repeat++)
+	{
+		bench_reset_();
+		call = 0;
+		drain = 0;
+
+		for (round = 0; BENCH_ROUNDS > round; round++)
+		{
+			/* Synchronous logger: the line goes through the transport in the call */
+			for (index = 0; BENCH_BATCH > index; index++)
+			{
+				start = bench_now_();
+				bench_log_(argc, round * BENCH_BATCH + index);
+				call += bench_since_(start);
+				bench_dma_run_(UINT32_MAX);
+			}
+
+			for (index = 0; BENCH_BATCH > index; index++)
+			{
+				start = bench_now_();
+				logger_drain(1);
+				drain += bench_since_(start);
+				bench_dma_run_(UINT32_MAX);
+			}
+		}
+
+		call_min = (call_min > call) ? call : call_min;
+		drain_min = (drain_min > drain) ? drain : drain_min;
+		irq_off_min = (irq_off_min > bench_irq_off_max_) ? bench_irq_off_max_ : irq_off_min;
+	}
+
+	fprintf(stderr, "%-12s %4lu %8lu %8lu %8lu %8lu\n", p_sink->p_name, (unsigned long)argc,
+			(unsigned long)(call_min / qty), (unsigned long)(drain_min / qty),
+			(unsigned long)(logger_stats.drain_bytes / qty), (unsigned long)irq_off_min);
+}
+
+/* No drop at "rate" msgs/S for BENCH_SUSTAIN_S simulated seconds, and the peak
+ * backlog of the last second not above the first one: logger records, transport
+ * bytes (one line of slack) */
+static bool bench_rate_ok_(uint32_t rate)
+{
+	uint32_t credit = 0;
+	uint32_t second;
+	uint32_t ms;
+	uint32_t index = 0;
+	uint32_t level;
+	uint32_t peak_records = 0;
+	uint32_t peak_bytes = 0;
+	uint32_t first_records = 0;
+	uint32_t first_bytes = 0;
+
+	bench_reset_();
+
+	for (second = 0; BENCH_SUSTAIN_S > second; second++)
+	{
+		peak_records = 0;
+		peak_bytes = 0;
+
+		for (ms = 0; BENCH_SECOND_MS > ms; ms++)
+		{
+			credit += rate;
+			while (BENCH_SECOND_MS <= credit)
+			{
+				credit -= BENCH_SECOND_MS;
+				bench_log_(4, index++);
+			}
+
+			logger_drain(LOGGER_CONFIG_DRAIN_QTY);
+			bench_dma_tick_();
+
+			level = LOGGER_CONFIG_RING_QTY - logger_free();
+			peak_records = (peak_records < level) ? level : peak_records;
+			level = UART_DMA_TX_RING_SIZE - uart_dma_tx_free();
+			peak_bytes = (peak_bytes < level) ? level : peak_bytes;
+		}
+
+		if (0 == second)
+		{
+			first_records = peak_records;
+			first_bytes = peak_bytes;
+		}
+	}
+
+	return (0 == logger_stats.dropped) && (0 == uart_dma_tx_stats.dropped) &&
+		   (peak_records <= first_records) && (peak_bytes <= (first_bytes + BENCH_LINE_SLACK));
+}
+
+static void bench_sustained_(const bench_sink_t *p_sink)
+{
+	uint32_t low = 0;
+	uint32_t high = BENCH_RATE_MAX + 1;
+	uint32_t rate;
+
+	logger_sink_set(p_sink->sink);
+	if ((false == p_sink->sustained) || (p_sink->sink != logger_sink_get()))
+	{
+		return;
+	}
+
+	/* Highest rate with no drop: binary search */
+	while (1 < (high - low))
+	{
+		rate = low + (high - low) / 2;
+		if (true == bench_rate_ok_(rate))
+		{
+			low = rate;
+		}
+		else
+		{
+			high = rate;
+		}
+	}
+
+	fprintf(stderr, "%-12s %s%lu msgs/S\n", p_sink->p_name,
+			(BENCH_RATE_MAX == low) ? ">= " : "", (unsigned long)low);
+}
+
+/********************** external functions definition ************************/
+int main(void)
+{
+	uint32_t sink;
+	uint32_t argc;
+
+	bench_platform_init_();
+	bench_calibrate_();
+
+	/* C_DEBUGEN: semihosting selectable, TXE: UART polling never waits */
+	bench_core_debug_.DHCSR = CoreDebug_DHCSR_C_DEBUGEN_Msk;
+	bench_usart_.SR = USART_SR_TXE;
+
+	fprintf(stderr, "logger: %s, ring %lu records, drain %lu per mS, unit %s\n",
+			(1 == LOGGER_CONFIG_TOKENIZED) ? "binary ring (tokenized)" :
+			(1 == LOGGER_CONFIG_DEFERRED) ? "deferred text" : "synchronous text",
+			(unsigned long)LOGGER_CONFIG_RING_QTY, (unsigned long)LOGGER_CONFIG_DRAIN_QTY, BENCH_UNIT);
+
+	fprintf(stderr, "\nsink         argc     call    drain  bytes/m  irq-off\n");
+	for (sink = 0; (sizeof(bench_sink_list_) / sizeof(bench_sink_list_[0])) > sink; sink++)
+	{
+		for (argc = 0; (sizeof(bench_argc_list_) / sizeof(bench_argc_list_[0])) > argc; argc++)
+		{
+			bench_cost_(&bench_sink_list_[sink], bench_argc_list_[argc]);
+		}
+	}
+
+	fprintf(stderr, "\nsustained, 4 arguments, no drop:\n");
+	for (sink = 0; (sizeof(bench_sink_list_) / sizeof(bench_sink_list_[0])) > sink; sink++)
+	{
+		bench_sustained_(&bench_sink_list_[sink]);
+	}
+
+	return 0;
+}
+
+/********************** end of file ******************************************/
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : bench_task.h
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ *
+ * Host benches on the task sources as they are (unity build): app/src/task_actuator.c
+ * & its back ends, plus app/src/task_sensor.c with BENCH_TASK_SENSOR (1), built with
+ * BENCH_QTY instances on stub HAL functions & a RAM image of the GPIO ports (trace,
+ * latency & end-to-end hooks compiled out, no log output). Included once, by the
+ * bench .c file, before its own code. With BENCH_TASK_SENSOR the bench provides
+ * HAL_GPIO_ReadPin() & put_event_task_system().
+ */
+
+#ifndef BENCH_BENCH_TASK_H_
+#define BENCH_BENCH_TASK_H_
+
+/********************** inclusions *******************************************/
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+
+#include "main.h"
+
+/********************** macros ***********************************************/
+#ifndef BENCH_TASK_SENSOR
+#define BENCH_TASK_SENSOR			(0)
+#endif
+
+/* Code under test: bench tables, no hooks, no log output */
+#define TASK_SENSOR_CONFIG_BOARD	(0)
+#define TASK_ACTUATOR_CONFIG_BOARD	(0)
+#define TASK_ACTUATOR_PATTERN_QTY_MAX	(BENCH_QTY)
+#define TASK_ACTUATOR_BAM_QTY_MAX	(BENCH_QTY)
+#define TRACE_CONFIG_ENABLE			(0)
+#define LATENCY_CONFIG_ENABLE		(0)
+#define E2E_CONFIG_ENABLE			(0)
+#define LOGGER_MODULE_LEVEL			(-1)
+
+/* GPIOA .. GPIOE: RAM image, same stride (before gpio_stage.h, its inline writes) */
+static uint8_t bench_gpio_[5][0x400] __attribute__((aligned(4)));
+
+#undef GPIOA_BASE
+#define GPIOA_BASE		((uintptr_t)bench_gpio_)
+#undef GPIOB_BASE
+#define GPIOB_BASE		(GPIOA_BASE + 0x400ul)
+
+/* No interrupts on the host */
+#define __asm(insn)		((void)0)
+
+#if !defined(__arm__)
+#define __DMB()			__sync_synchronize()
+#endif
+
+/********************** code under test **************************************/
+#if (1 == BENCH_TASK_SENSOR)
+#include "task_system_attribute.h"
+#include "task_sensor_attribute.h"
+#endif
+#include "task_actuator_attribute.h"
+
+#if (1 == BENCH_TASK_SENSOR)
+task_sensor_cfg_t task_sensor_cfg_list[BENCH_QTY];
+#endif
+task_actuator_cfg_t task_actuator_cfg_list[BENCH_QTY];
+
+/* Each module sets its own LOGGER_MODULE */
+#include "../app/src/gpio_stage.c"
+#if (1 == BENCH_TASK_SENSOR)
+#include "../app/src/task_sensor.c"
+#undef LOGGER_MODULE
+#endif
+#include "../app/src/task_actuator_tim.c"
+#undef LOGGER_MODULE
+#include "../app/src/task_actuator_pattern.c"
+#undef LOGGER_MODULE
+#include "../app/src/task_actuator_bam.c"
+#undef LOGGER_MODULE
+#include "../app/src/task_actuator_interface.c"
+#undef LOGGER_MODULE
+#include "../app/src/task_actuator.c"
+
+#undef __asm
+
+/********************** HAL & timer_service stubs ****************************/
+uint32_t SystemCoreClock = 64000000ul;
+
+void HAL_GPIO_WritePin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin, GPIO_PinState PinState)
+{
+}
+
+void HAL_GPIO_Init(GPIO_TypeDef *GPIOx, GPIO_InitTypeDef *GPIO_Init)
+{
+}
+
+void HAL_NVIC_SetPriority(IRQn_Type IRQn, uint32_t PreemptPriority, uint32_t SubPriority)
+{
+}
+
+void HAL_NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+}
+
+uint32_t HAL_RCC_GetPCLK1Freq(void)
+{
+	return SystemCoreClock / 2ul;
+}
+
+uint32_t HAL_RCC_GetPCLK2Freq(void)
+{
+	return SystemCoreClock;
+}
+
+/* No timer free: pulses count ticks */
+uint32_t timer_service_add(uint32_t delay_us, uint32_t period_us, timer_service_cb_t callback, void *p_arg)
+{
+	return TIMER_SERVICE_NONE;
+}
+
+void timer_service_cancel(uint32_t id)
+{
+}
+
+/********************** bench functions **************************************/
+static inline uint64_t bench_now_ns(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ((uint64_t)ts.tv_sec * 1000000000ull) + (uint64_t)ts.tv_nsec;
+}
+
+#endif /* BENCH_BENCH_TASK_H_ */
+
+/********************** end of file ******************************************/
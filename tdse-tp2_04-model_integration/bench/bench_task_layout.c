@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2023 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ * FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ * COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ * INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+ * HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT,
+ * STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING
+ * IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * @file   : bench_task_layout.c
+ * @date   : Oct 18, 2026
+ * @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+ * @version	v1.0.0
+ *
+ * Host benchmark: array of structures (AoS) vs structure of arrays (SoA) layout of
+ * the sensor & actuator data (TASK_xx_CONFIG_SOA). app/src/task_sensor.c &
+ * app/src/task_actuator.c are built as they are (bench_task.h) with BENCH_QTY
+ * instances each.
+ *  - every 16 ticks one input toggles (EXTI: task_sensor_wakeup()) and the actuator
+ *    with the same index gets ON / OFF, as task_system would put it
+ *  - per tick: task_sensor_update() + task_actuator_update(), as app_update() runs
+ *    them (trace, latency & end-to-end hooks compiled out, no log output)
+ * Reports the per tick cost, the data RAM of both tables & the put_event_task_system()
+ * calls (debounced edges & gestures), one build per layout and instance quantity.
+ *
+ * Build & run (host):
+ *  for soa in 0 1; do for qty in 1 64 1024; do
+ *   cc -O2 -std=gnu11 -DSTM32F103xB -DUSE_HAL_DRIVER -DBENCH_QTY=$qty \
+ *    -DTASK_SENSOR_CONFIG_SOA=$soa -DTASK_ACTUATOR_CONFIG_SOA=$soa -I../app/inc -I../Core/Inc \
+ *    -I../Drivers/STM32F1xx_HAL_Driver/Inc -I../Drivers/CMSIS/Device/ST/STM32F1xx/Include \
+ *    -I../Drivers/CMSIS/Include -o bench_task_layout bench_task_layout.c && ./bench_task_layout
+ *  done; done
+ */
+
+/********************** inclusions *******************************************/
+#include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "main.h"
+
+/********************** macros and definitions *******************************/
+#ifndef BENCH_QTY
+#define BENCH_QTY			(64ul)	/* sensors & actuators */
+#endif
+#define BENCH_TICK_QTY		(20000ul)
+#define BENCH_TASK_SENSOR	(1)		/* task_sensor.c too */
+
+/********************** code under test **************************************/
+#include "bench_task.h"
+
+/********************** internal data definition *****************************/
+/* Input levels, by sensor (HAL_GPIO_ReadPin() pin == index) */
+static uint8_t bench_input_[BENCH_QTY];
+static uint32_t bench_event_qty_;
+
+/********************** HAL & task_system stubs ******************************/
+GPIO_PinState HAL_GPIO_ReadPin(GPIO_TypeDef *GPIOx, uint16_t GPIO_Pin)
+{
+	return (0 != bench_input_[GPIO_Pin]) ? GPIO_PIN_RESET : GPIO_PIN_SET;
+}
+
+void put_event_task_system(task_system_ev_t event)
+{
+	bench_event_qty_++;
+}
+
+/********************** internal functions definition ************************/
+/* Board-like tables: active low buttons, LEDs spread over the five ports */
+static void bench_cfg_init_(void)
+{
+	uint32_t index;
+
+	for (index = 0; BENCH_QTY > index; index++)
+	{
+		task_sensor_cfg_list[index] = (task_sensor_cfg_t){(task_sensor_id_t)index,
+			GPIOA, (uint16_t)index, GPIO_PIN_RESET, DEL_BTN_XX_MAX,
+			EV_SYS_IDLE, EV_SYS_LOOP_DET,
+			DEL_GES_XX_LONG, DEL_GES_XX_DOUBLE, DEL_GES_XX_CHORD, (task_sensor_id_t)index,
+			EV_SYS_BTN_LONG_PRESS, EV_SYS_BTN_DOUBLE_CLICK, EV_SYS_BTN_CHORD};
+
+		task_actuator_cfg_list[index] = (task_actuator_cfg_t){(task_actuator_id_t)index,
+			(GPIO_TypeDef *)(GPIOA_BASE + (((index >> 4) % GPIO_STAGE_PORT_QTY) * GPIO_STAGE_PORT_STRIDE)),
+			(uint16_t)(1ul << (index & 15ul)), GPIO_PIN_SET, GPIO_PIN_RESET,
+			DEL_LED_XX_BLI, DEL_LED_XX_PUL,
+			KIND_LED_XX_GPIO, NULL, 0, LED_XX_BRIGHTNESS_MAX};
+	}
+}
+
+/* Inputs toggle rarely, as real buttons do: one instance every 16 ticks */
+static void bench_stimulus_(uint32_t tick)
+{
+	uint32_t index;
+
+	if (0 == (tick & 15ul))
+	{
+		index = (tick >> 4) % BENCH_QTY;
+		bench_input_[index] ^= 1;
+		task_sensor_wakeup((uint16_t)index);
+		put_event_task_actuator((0 != bench_input_[index]) ? EV_LED_XX_ON : EV_LED_XX_OFF,
+								(task_actuator_id_t)index);
+	}
+}
+
+/********************** external functions definition ************************/
+int main(void)
+{
+	uint32_t tick;
+	uint64_t t0;
+	double ns_tick;
+	uint32_t ram;
+
+	bench_cfg_init_();
+	task_sensor_init(NULL);
+	task_actuator_init(NULL);
+
+	t0 = bench_now_ns();
+	for (tick = 0; BENCH_TICK_QTY > tick; tick++)
+	{
+		bench_stimulus_(tick);
+
+		g_task_sensor_tick_cnt = 1;
+		task_sensor_update(NULL);
+		g_task_actuator_tick_cnt = 1;
+		task_actuator_update(NULL);
+	}
+	ns_tick = (double)(bench_now_ns() - t0) / (double)BENCH_TICK_QTY;
+
+	/* Data RAM of the sensor & actuator tables, as laid out on target */
+#if (1 == TASK_SENSOR_CONFIG_SOA)
+	ram = (uint32_t)(sizeof(task_sensor_dta_tick) + sizeof(task_sensor_dta_state) + sizeof(task_sensor_dta_event));
+#else
+	ram = (uint32_t)sizeof(task_sensor_dta_list);
+#endif
+#if (1 == TASK_ACTUATOR_CONFIG_SOA)
+	ram += (uint32_t)(sizeof(task_actuator_dta_tick) + sizeof(task_actuator_dta_state) +
+					  sizeof(task_actuator_dta_event) + sizeof(task_actuator_dta_flag));
+#else
+	ram += (uint32_t)sizeof(task_actuator_dta_list);
+#endif
+
+	printf("%-4s %5lu instances %10.1f ns/tick %8lu bytes %8lu events\n",
+		   (1 == TASK_SENSOR_CONFIG_SOA) ? "SoA" : "AoS", (unsigned long)BENCH_QTY, ns_tick,
+		   (unsigned long)ram, (unsigned long)bench_event_qty_);
+
+	return 0;
+}
+
+/********************** end of file ******************************************/
@@ -0,0 +1,194 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+# All rights reserved.
+#
+# @file   : logger_decode.py
+# @date   : Oct 18, 2026
+# @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+# @version	v1.0.0
+#
+# Tokenized logger decoder (LOGGER_CONFIG_TOKENIZED, app/inc/logger.h).
+#
+# Frame: sync (0xA5), full << 7 | level << 4 | argc, id (16-bit LE),
+#        stamp (full: 64-bit LE cycles, else 32-bit LE delta), argc x argument (32-bit LE).
+# The id is the offset of the format string in the ELF ".logger_fmt" section,
+# "%s" arguments are addresses resolved from the loaded sections (.rodata, ...).
+# Cycle stamps are shown in microseconds (--clock, SystemCoreClock).
+#
+# Usage:
+#   stty -F /dev/ttyACM0 115200 raw
+#   python3 tools/logger_decode.py Debug/tdse-tp2_04-model_integration.elf /dev/ttyACM0
+#   python3 tools/logger_decode.py firmware.elf capture.bin
+#   python3 tools/logger_decode.py --text capture.txt    (text mode, stamps to uS only)
+#
+
+import argparse
+import re
+import struct
+import sys
+
+LOGGER_TOKEN_SYNC = 0xA5
+LOGGER_TOKEN_HEADER_LEN = 4
+LOGGER_TOKEN_FULL = 0x80
+LOGGER_CLOCK_HZ = 64000000
+LOGGER_LEVEL_TAG = ["[error] ", "[warn] ", "[info] ", "[debug] ", "[trace] "]
+
+SHT_PROGBITS = 1
+SHF_ALLOC = 0x2
+
+C_FORMAT = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|j|z|t)?([diouxXcsp%])")
+TEXT_STAMP = re.compile(r"^([0-9a-f]{16}) ")
+
+
+def stamp_us(stamp, clock):
+    if stamp is None:
+        return "[%12s uS] " % "?"
+    return "[%12d uS] " % (stamp * 1000000 // clock)
+
+
+class Elf:
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF":
+            raise ValueError("%s: not an ELF file" % path)
+        is64 = (2 == self.data[4])
+        end = "<" if (1 == self.data[5]) else ">"
+        if is64:
+            shoff, = struct.unpack_from(end + "Q", self.data, 0x28)
+            shentsize, shnum, shstrndx = struct.unpack_from(end + "HHH", self.data, 0x3A)
+            sh_fmt = end + "IIQQQQIIQQ"
+        else:
+            shoff, = struct.unpack_from(end + "I", self.data, 0x20)
+            shentsize, shnum, shstrndx = struct.unpack_from(end + "HHH", self.data, 0x2E)
+            sh_fmt = end + "IIIIIIIIII"
+        sections = []
+        for index in range(shnum):
+            name, stype, flags, addr, offset, size = \
+                struct.unpack_from(sh_fmt, self.data, shoff + index * shentsize)[:6]
+            sections.append([name, stype, flags, addr, offset, size])
+        strtab = sections[shstrndx]
+        for section in sections:
+            section[0] = self.cstring(strtab[4] + section[0])
+        self.sections = sections
+
+    def cstring(self, offset):
+        return self.data[offset:self.data.index(b"\0", offset)].decode("utf-8", "replace")
+
+    def section(self, name):
+        for section in self.sections:
+            if name == section[0]:
+                return section
+        raise ValueError("no %s section, build with LOGGER_CONFIG_TOKENIZED = 1" % name)
+
+    def string_at(self, addr):
+        for name, stype, flags, base, offset, size in self.sections:
+            if (SHT_PROGBITS == stype) and (flags & SHF_ALLOC) and (base <= addr < base + size):
+                return self.cstring(offset + addr - base)
+        return "<0x%08x>" % addr
+
+
+class Decoder:
+    def __init__(self, elf, clock):
+        self.elf = elf
+        self.clock = clock
+        self.stamp = None
+        _, _, _, self.base, self.offset, self.size = elf.section(".logger_fmt")
+
+    def format_string(self, token):
+        # On target the section is linked at 0, host builds keep the low 16 bits
+        offset = (token - self.base) & 0xFFFF
+        if offset >= self.size:
+            return None
+        return self.elf.cstring(self.offset + offset)
+
+    def render(self, fmt, args):
+        args = list(args)
+
+        def convert(match):
+            flags, _, conv = match.groups()
+            if "%" == conv:
+                return "%"
+            arg = args.pop(0) if args else 0
+            if "s" == conv:
+                return ("%" + flags + "s") % self.elf.string_at(arg)
+            if conv in "di":
+                return ("%" + flags + "d") % (arg - (1 << 32) if arg & 0x80000000 else arg)
+            if "p" == conv:
+                return "0x%08x" % arg
+            if "c" == conv:
+                return chr(arg & 0xFF)
+            return ("%" + flags + conv) % arg
+
+        return C_FORMAT.sub(convert, fmt)
+
+    def frames(self, stream):
+        buffer = b""
+        while True:
+            chunk = stream.read(1)
+            if not chunk:
+                return
+            buffer += chunk
+            # Resync on the sync byte, validate the id against the format table
+            while buffer:
+                if LOGGER_TOKEN_SYNC != buffer[0]:
+                    buffer = buffer[1:]
+                    continue
+                if len(buffer) < LOGGER_TOKEN_HEADER_LEN:
+                    break
+                full = buffer[1] & LOGGER_TOKEN_FULL
+                level, argc = (buffer[1] >> 4) & 0x07, buffer[1] & 0x0F
+                token = buffer[2] | (buffer[3] << 8)
+                fmt = self.format_string(token)
+                if (fmt is None) or (8 < argc) or (len(LOGGER_LEVEL_TAG) <= level):
+                    buffer = buffer[1:]
+                    continue
+                stamp_len = 8 if full else 4
+                frame_len = LOGGER_TOKEN_HEADER_LEN + stamp_len + 4 * argc
+                if len(buffer) < frame_len:
+                    break
+                stamp, = struct.unpack_from("<Q" if full else "<I", buffer, LOGGER_TOKEN_HEADER_LEN)
+                if full:
+                    self.stamp = stamp
+                elif self.stamp is not None:
+                    self.stamp += stamp
+                args = struct.unpack_from("<%dI" % argc, buffer, LOGGER_TOKEN_HEADER_LEN + stamp_len)
+                buffer = buffer[frame_len:]
+                yield stamp_us(self.stamp, self.clock) + LOGGER_LEVEL_TAG[level] + self.render(fmt, args)
+
+
+def text_lines(stream, clock):
+    for raw in stream:
+        line = raw.decode("utf-8", "replace").rstrip("\r\n")
+        match = TEXT_STAMP.match(line)
+        if match:
+            line = stamp_us(int(match.group(1), 16), clock) + line[match.end():]
+        yield line
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description="Logger decoder (app/inc/logger.h)")
+    parser.add_argument("--clock", type=int, default=LOGGER_CLOCK_HZ, help="SystemCoreClock [Hz]")
+    parser.add_argument("--text", action="store_true", help="text mode: only convert the stamps")
+    parser.add_argument("elf", nargs="?", help="firmware ELF (tokenized mode)")
+    parser.add_argument("input", nargs="?", default="-", help="capture file, tty or - (stdin)")
+    args = parser.parse_args(argv[1:])
+    if args.text and (args.elf is not None) and ("-" == args.input):
+        args.input = args.elf
+    if (not args.text) and (args.elf is None):
+        parser.error("the firmware ELF is required in tokenized mode")
+
+    stream = sys.stdin.buffer if "-" == args.input else open(args.input, "rb", buffering=0)
+    lines = text_lines(stream, args.clock) if args.text else \
+        Decoder(Elf(args.elf), args.clock).frames(stream)
+    try:
+        for line in lines:
+            print(line, flush=True)
+    except KeyboardInterrupt:
+        pass
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
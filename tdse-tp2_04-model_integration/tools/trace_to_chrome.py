@@ -0,0 +1,210 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2026 Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>.
+# All rights reserved.
+#
+# @file   : trace_to_chrome.py
+# @date   : Oct 18, 2026
+# @author : Juan Manuel Cruz <jcruz@fi.uba.ar> <jcruz@frba.utn.edu.ar>
+# @version	v1.0.0
+#
+# Execution trace converter (app/inc/trace.h) to Chrome trace-event JSON,
+# open it in https://ui.perfetto.dev or chrome://tracing.
+#
+# Dump: "#T begin <records> <SystemCoreClock>", then one "#T <stamp> <type> <id> <arg>"
+#       line per record (hex, stamp: 32-bit CYCCNT), then "#T end".
+# Other bytes on the line (log text, tokenized frames) are skipped, each dump becomes
+# one process: tasks & ISRs as slices, queue put/get as instants, one track per FSM.
+#
+# Usage:
+#   stty -F /dev/ttyACM0 115200 raw
+#   cat /dev/ttyACM0 > capture.bin                    (until "#T end")
+#   python3 tools/trace_to_chrome.py capture.bin -o trace.json
+#
+
+import argparse
+import json
+import re
+import sys
+
+TRACE_CLOCK_HZ = 64000000
+
+TRACE_TYPE_TASK_BEGIN = 0
+TRACE_TYPE_TASK_END = 1
+TRACE_TYPE_ISR_ENTER = 2
+TRACE_TYPE_ISR_EXIT = 3
+TRACE_TYPE_EVENT_PUT = 4
+TRACE_TYPE_EVENT_GET = 5
+TRACE_TYPE_STATE = 6
+
+# Same order as task_cfg_list[] (app.c) and the enums in trace.h & *_attribute.h
+TASK_NAME = ["task_sensor", "task_system", "task_actuator"]
+ISR_NAME = ["SysTick", "EXTI15_10", "TIM4 (bam)", "DMA1_Ch7 (uart tx)", "TIM2 (timer service)",
+            "DMA1_Ch6 (uart rx)", "USART2 (uart rx idle)"]
+QUEUE_NAME = ["system", "actuator"]
+FSM_NAME = ["sensor", "gesture", "system", "actuator"]
+FSM_STATE = [
+    ["UP", "FALLING", "DOWN", "RISING"],
+    ["IDLE", "PRESSED", "RELEASED", "HOLD"],
+    ["IDLE", "ACTIVE_01", "ACTIVE_02", "ACTIVE_03", "ACTIVE_04", "ACTIVE_05", "ACTIVE_06"],
+    ["OFF", "ON", "BLINK_ON", "BLINK_OFF", "PULSE", "PATTERN"],
+]
+EVENT_NAME = [
+    ["IDLE", "LOOP_DET", "NOT_LOOP_DET", "MANUAL_BTN", "NOT_MANUAL_BTN", "IR_PHO_CELL",
+     "NOT_IR_PHO_CELL", "BTN_LONG_PRESS", "BTN_DOUBLE_CLICK", "BTN_CHORD"],
+    ["OFF", "ON", "NOT_BLINK", "BLINK", "PULSE", "PATTERN"],
+]
+
+TID_TASKS = 1
+TID_ISR = 2
+TID_EVENTS = 3
+TID_FSM = 16
+
+TRACE_LINE = re.compile(rb"#T (?:(begin) ([0-9a-f]{8}) ([0-9a-f]{8})|(end)|"
+                        rb"([0-9a-f]{8}) ([0-9a-f]{2}) ([0-9a-f]{2}) ([0-9a-f]{4}))\r?\n")
+
+
+def name(table, index, prefix):
+    return table[index] if index < len(table) else "%s%d" % (prefix, index)
+
+
+class Dump:
+    def __init__(self, pid, clock):
+        self.pid = pid
+        self.clock = clock
+        self.events = []
+        self.cycles = 0
+        self.last = None
+        self.depth = {TID_TASKS: 0, TID_ISR: 0}
+        self.fsm = {}
+
+    def ts(self, stamp):
+        # 32-bit CYCCNT unwrapped: records are in time order
+        if self.last is not None:
+            self.cycles += (stamp - self.last) & 0xFFFFFFFF
+        self.last = stamp
+        return self.cycles * 1000000.0 / self.clock
+
+    def emit(self, ph, tid, ts, name, cat, args=None):
+        event = {"ph": ph, "pid": self.pid, "tid": tid, "ts": ts, "name": name, "cat": cat}
+        if "i" == ph:
+            event["s"] = "t"
+        if args:
+            event["args"] = args
+        self.events.append(event)
+
+    def slice(self, begin, tid, ts, name, cat):
+        if begin:
+            self.depth[tid] += 1
+            self.emit("B", tid, ts, name, cat)
+        elif 0 < self.depth[tid]:
+            # An end without its begin (wrapped out of the ring) is dropped
+            self.depth[tid] -= 1
+            self.emit("E", tid, ts, name, cat)
+
+    def record(self, stamp, kind, ident, arg):
+        ts = self.ts(stamp)
+        if kind in (TRACE_TYPE_TASK_BEGIN, TRACE_TYPE_TASK_END):
+            self.slice(TRACE_TYPE_TASK_BEGIN == kind, TID_TASKS, ts,
+                       name(TASK_NAME, ident, "task_"), "task")
+        elif kind in (TRACE_TYPE_ISR_ENTER, TRACE_TYPE_ISR_EXIT):
+            self.slice(TRACE_TYPE_ISR_ENTER == kind, TID_ISR, ts,
+                       name(ISR_NAME, ident, "isr_"), "isr")
+        elif kind in (TRACE_TYPE_EVENT_PUT, TRACE_TYPE_EVENT_GET):
+            queue = name(QUEUE_NAME, ident, "queue_")
+            table = EVENT_NAME[ident] if ident < len(EVENT_NAME) else []
+            # Actuator events carry the actuator index in the high byte
+            instance, event = (arg >> 8, arg & 0xFF) if 1 == ident else (None, arg)
+            label = "%s %s %s" % ("put" if TRACE_TYPE_EVENT_PUT == kind else "get", queue,
+                                  name(table, event, "ev_"))
+            args = {"event": event}
+            if instance is not None:
+                label += " [%d]" % instance
+                args["actuator"] = instance
+            self.emit("i", TID_EVENTS, ts, label, "event", args)
+        elif TRACE_TYPE_STATE == kind:
+            instance, state = arg >> 8, arg & 0xFF
+            key = (ident, instance)
+            tid = TID_FSM + 256 * ident + instance
+            if key not in self.fsm:
+                self.thread(tid, "%s[%d]" % (name(FSM_NAME, ident, "fsm_"), instance))
+            else:
+                self.emit("E", tid, ts, self.fsm[key], "state")
+            self.fsm[key] = name(FSM_STATE[ident] if ident < len(FSM_STATE) else [], state, "st_")
+            self.emit("B", tid, ts, self.fsm[key], "state")
+
+    def thread(self, tid, label):
+        self.events.append({"ph": "M", "pid": self.pid, "tid": tid, "name": "thread_name",
+                            "args": {"name": label}})
+
+    def close(self):
+        # Slices still open at the trigger end with the last record
+        ts = self.cycles * 1000000.0 / self.clock
+        for tid in (TID_TASKS, TID_ISR):
+            while 0 < self.depth[tid]:
+                self.depth[tid] -= 1
+                self.emit("E", tid, ts, "", "open")
+        for (ident, instance), state in self.fsm.items():
+            self.emit("E", TID_FSM + 256 * ident + instance, ts, state, "state")
+        self.events.append({"ph": "M", "pid": self.pid, "name": "process_name",
+                            "args": {"name": "trace dump %d" % self.pid}})
+        self.thread(TID_TASKS, "tasks")
+        self.thread(TID_ISR, "isr")
+        self.thread(TID_EVENTS, "events")
+        return self.events
+
+
+def convert(data, clock_default):
+    events = []
+    dump = None
+    dumps = 0
+    for match in TRACE_LINE.finditer(data):
+        if match.group(1):
+            if dump is not None:
+                events += dump.close()
+            dumps += 1
+            clock = int(match.group(3), 16) or clock_default
+            dump = Dump(dumps, clock)
+        elif match.group(4):
+            if dump is not None:
+                events += dump.close()
+            dump = None
+        elif dump is not None:
+            dump.record(int(match.group(5), 16), int(match.group(6), 16),
+                        int(match.group(7), 16), int(match.group(8), 16))
+    if dump is not None:
+        events += dump.close()
+    return events, dumps
+
+
+def main(argv):
+    parser = argparse.ArgumentParser(description="Trace to Chrome trace-event JSON (app/inc/trace.h)")
+    parser.add_argument("--clock", type=int, default=TRACE_CLOCK_HZ,
+                        help="SystemCoreClock [Hz], when the dump does not carry it")
+    parser.add_argument("input", nargs="?", default="-", help="capture file or - (stdin)")
+    parser.add_argument("-o", "--output", default="-", help="JSON file or - (stdout)")
+    args = parser.parse_args(argv[1:])
+
+    if "-" == args.input:
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.input, "rb") as f:
+            data = f.read()
+
+    events, dumps = convert(data, args.clock)
+    if 0 == dumps:
+        sys.stderr.write("no trace dump (\"#T begin\") found\n")
+        return 1
+
+    text = json.dumps({"traceEvents": events, "displayTimeUnit": "ns"}, indent=0)
+    if "-" == args.output:
+        sys.stdout.write(text + "\n")
+    else:
+        with open(args.output, "w") as f:
+            f.write(text + "\n")
+    sys.stderr.write("%d dump(s), %d events\n" % (dumps, len(events)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))